@@ -0,0 +1,69 @@
+#include <array>
+#include <memory_resource>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// HEAP VS PER-REQUEST ARENA
+struct ArenaPoint
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(ArenaPoint,
+        (double, x)
+        (double, y)
+        (std::string, label, "")
+    )
+    // clang-format on
+};
+
+struct ArenaShape
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(ArenaShape,
+        (int, id)
+        (std::string, name)
+        (std::optional<std::string>, comment, std::nullopt)
+        (std::vector<ArenaPoint>, points)
+    )
+    // clang-format on
+};
+
+// the strings are longer than the small string buffer, so every one of them is allocated
+static ArenaShape make_shape()
+{
+    ArenaShape shape{1, "a closed polygon with 64 points", "the comment of the closed polygon", {}};
+    for (int i = 0; i < 64; ++i)
+        shape.points.push_back({i * 0.5, i * 1.5, "a point of the closed polygon"});
+    return shape;
+}
+
+// one request: encode into a DOM and decode the DOM again
+template <typename BasicJsonType> static void round_trip(const ArenaShape &shape)
+{
+    BasicJsonType j = shape;
+    benchmark::DoNotOptimize(j.template get<ArenaShape>());
+}
+
+static void BM_RoundTripHeap(benchmark::State &state)
+{
+    const auto shape = make_shape();
+    for (auto _ : state)
+        round_trip<nlohmann::json>(shape);
+}
+BENCHMARK(BM_RoundTripHeap)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_RoundTripArena(benchmark::State &state)
+{
+    const auto shape = make_shape();
+    std::array<std::byte, 64 * 1024> buffer;
+    for (auto _ : state)
+    {
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+        json_ext::arena_scope scope(arena);
+        round_trip<json_ext::arena_json>(shape);
+    }
+}
+BENCHMARK(BM_RoundTripArena)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+#include <nlohmann/json_ext_batch.hpp>
+
+using nlohmann::json;
+
+////////////////////////////////////////////////////////////////////////////////
+/// SINGLE THREADED DOM VS PARALLEL BATCH
+struct BatchRecord
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(BatchRecord,
+        (int, id)
+        (std::string, name)
+        (std::optional<std::string>, comment, std::nullopt)
+        (std::vector<double>, values)
+    )
+    // clang-format on
+};
+
+static const std::string &records_array()
+{
+    static const std::string text = [] {
+        std::vector<BatchRecord> records;
+        for (int i = 0; i < 100000; ++i)
+            records.push_back({i, "record", "comment", {i * 0.5, i * 1.5, 3.0}});
+        return json(records).dump();
+    }();
+    return text;
+}
+
+static void BM_BatchDom(benchmark::State &state)
+{
+    const auto &text = records_array();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json::parse(text).get<std::vector<BatchRecord>>());
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_BatchDom)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_BatchParallel(benchmark::State &state)
+{
+    const auto &text = records_array();
+    const json_ext::batch_options options{static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json_ext::decode_batch<BatchRecord>(text, json_ext::batch_format::array, options));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_BatchParallel)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond)->UseRealTime();
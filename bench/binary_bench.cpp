@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+using nlohmann::json;
+
+////////////////////////////////////////////////////////////////////////////////
+/// DOM VS DIRECT MSGPACK
+struct BinaryPoint
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(BinaryPoint,
+        (double, x)
+        (double, y)
+        (std::string, label, "")
+    )
+    // clang-format on
+};
+
+struct BinaryShape
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(BinaryShape,
+        (int, id)
+        (std::string, name)
+        (std::optional<std::string>, comment, std::nullopt)
+        (std::vector<BinaryPoint>, points)
+    )
+    // clang-format on
+};
+
+static BinaryShape make_shape()
+{
+    BinaryShape shape{1, "polygon", "closed", {}};
+    for (int i = 0; i < 64; ++i)
+        shape.points.push_back({i * 0.5, i * 1.5, "point"});
+    return shape;
+}
+
+static void BM_EncodeMsgpackDom(benchmark::State &state)
+{
+    const auto shape = make_shape();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json::to_msgpack(json(shape)));
+}
+BENCHMARK(BM_EncodeMsgpackDom);
+
+static void BM_EncodeMsgpackDirect(benchmark::State &state)
+{
+    const auto shape = make_shape();
+    std::vector<std::uint8_t> out;
+    for (auto _ : state)
+    {
+        out.clear();
+        json_ext::write_binary<json_ext::binary_format::msgpack>(shape, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_EncodeMsgpackDirect);
+
+static void BM_DecodeMsgpackDom(benchmark::State &state)
+{
+    const auto bytes = json::to_msgpack(json(make_shape()));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json::from_msgpack(bytes).get<BinaryShape>());
+}
+BENCHMARK(BM_DecodeMsgpackDom);
+
+static void BM_DecodeMsgpackDirect(benchmark::State &state)
+{
+    const auto bytes = json::to_msgpack(json(make_shape()));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json_ext::from_msgpack<BinaryShape>(bytes));
+}
+BENCHMARK(BM_DecodeMsgpackDirect);
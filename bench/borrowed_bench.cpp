@@ -0,0 +1,70 @@
+#include <array>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// DECODING HEADERS WITH OWNED VS BORROWED STRINGS
+template <typename String> struct BorrowHeader
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(BorrowHeader,
+        (String, name)
+        (String, value)
+    )
+    // clang-format on
+};
+
+template <typename String> struct BorrowRequest
+{
+    using Headers = std::vector<BorrowHeader<String>>;
+
+    // clang-format off
+    NLOHMANN_SERIALIZE(BorrowRequest,
+        (String, method)
+        (String, path)
+        (String, host)
+        (Headers, headers)
+    )
+    // clang-format on
+};
+
+// the values are longer than the small string buffer, as most header values are
+static std::string make_request()
+{
+    BorrowRequest<std::string> request{"GET", "/api/v1/customers/42/orders?page=3", "shop.example.com", {}};
+    for (int i = 0; i < 16; ++i)
+        request.headers.push_back(
+            {"X-Header-" + std::to_string(i), "a header value which is long enough " + std::to_string(i)});
+    return json_ext::dump(request);
+}
+
+static void BM_HeadersParseInto(benchmark::State &state)
+{
+    const auto input = make_request();
+    for (auto _ : state)
+    {
+        const auto request = json_ext::parse_into<BorrowRequest<std::string>>(input);
+        benchmark::DoNotOptimize(request.headers.back().value.data());
+    }
+}
+BENCHMARK(BM_HeadersParseInto);
+
+static void BM_HeadersParseBorrowed(benchmark::State &state)
+{
+    const auto input = make_request();
+    std::array<std::byte, 4096> buffer;
+    for (auto _ : state)
+    {
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+        const auto request = json_ext::parse_borrowed<BorrowRequest<std::string_view>>(input, arena);
+        benchmark::DoNotOptimize(request.headers.back().value.data());
+    }
+}
+BENCHMARK(BM_HeadersParseBorrowed);
@@ -0,0 +1,148 @@
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// ROWS VS COLUMNS
+struct ColumnsTrade
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(ColumnsTrade,
+        (std::string, trade_id)
+        (std::string, symbol)
+        (std::int64_t, timestamp)
+        (double, price)
+        (std::int64_t, quantity, 1)
+        (std::optional<double>, fee, std::nullopt)
+        (std::string, venue, "primary")
+        (std::vector<std::string>, flags, {})
+    )
+    // clang-format on
+};
+
+using ColumnsTrades = json_ext::columns<ColumnsTrade>;
+
+static std::string make_input()
+{
+    std::vector<ColumnsTrade> trades;
+    for (int i = 0; i < 16384; ++i)
+    {
+        ColumnsTrade trade{"trade-" + std::to_string(i), "SYM" + std::to_string(i % 64), 1700000000000 + i,
+                           100 + i % 97 * 0.25};
+        trade.quantity = i % 13 + 1;
+        if (i % 3 == 0)
+            trade.fee = 0.05;
+        if (i % 10 == 0)
+            trade.flags = {"odd_lot", "late"};
+        trades.push_back(std::move(trade));
+    }
+    return json_ext::dump(trades);
+}
+
+static void BM_ColumnsParseRows(benchmark::State &state)
+{
+    const auto input = make_input();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json_ext::parse_into<std::vector<ColumnsTrade>>(input));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_ColumnsParseRows);
+
+static void BM_ColumnsParseColumns(benchmark::State &state)
+{
+    const auto input = make_input();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json_ext::parse_into<ColumnsTrades>(input));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_ColumnsParseColumns);
+
+// the scans read one double per row, the rows drag the whole ColumnsTrade through the cache
+static void BM_ColumnsSumRows(benchmark::State &state)
+{
+    const auto trades = json_ext::parse_into<std::vector<ColumnsTrade>>(make_input());
+    for (auto _ : state)
+    {
+        double sum = 0;
+        for (const auto &trade : trades)
+            sum += trade.price;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * trades.size()));
+}
+BENCHMARK(BM_ColumnsSumRows);
+
+static void BM_ColumnsSumColumns(benchmark::State &state)
+{
+    const auto trades = json_ext::parse_into<ColumnsTrades>(make_input());
+    for (auto _ : state)
+    {
+        double sum = 0;
+        for (auto price : trades.column<&ColumnsTrade::price>())
+            sum += price;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * trades.size()));
+}
+BENCHMARK(BM_ColumnsSumColumns);
+
+static void BM_ColumnsFilterRows(benchmark::State &state)
+{
+    const auto trades = json_ext::parse_into<std::vector<ColumnsTrade>>(make_input());
+    for (auto _ : state)
+    {
+        std::int64_t quantity = 0;
+        for (const auto &trade : trades)
+            quantity += trade.price > 110 ? trade.quantity : 0;
+        benchmark::DoNotOptimize(quantity);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * trades.size()));
+}
+BENCHMARK(BM_ColumnsFilterRows);
+
+static void BM_ColumnsFilterColumns(benchmark::State &state)
+{
+    const auto trades = json_ext::parse_into<ColumnsTrades>(make_input());
+    for (auto _ : state)
+    {
+        const auto *prices = trades.column<&ColumnsTrade::price>().data();
+        const auto *quantities = trades.column<&ColumnsTrade::quantity>().data();
+        std::int64_t quantity = 0;
+        for (std::size_t i = 0; i < trades.size(); ++i)
+            quantity += prices[i] > 110 ? quantities[i] : 0;
+        benchmark::DoNotOptimize(quantity);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * trades.size()));
+}
+BENCHMARK(BM_ColumnsFilterColumns);
+
+static void BM_ColumnsWriteRows(benchmark::State &state)
+{
+    const auto trades = json_ext::parse_into<std::vector<ColumnsTrade>>(make_input());
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        json_ext::write(trades, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_ColumnsWriteRows);
+
+static void BM_ColumnsWriteColumns(benchmark::State &state)
+{
+    const auto trades = json_ext::parse_into<ColumnsTrades>(make_input());
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        json_ext::write(trades, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_ColumnsWriteColumns);
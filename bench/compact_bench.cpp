@@ -0,0 +1,113 @@
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// FULL VS COMPACT WIRE PROFILE
+struct CompactSample
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(CompactSample,
+        (std::string, device_id, , "d")
+        (std::int64_t, timestamp, , "t")
+        (double, temperature, 0.0, "tmp")
+        (std::optional<double>, humidity, std::nullopt, "hum")
+        (std::optional<double>, pressure, std::nullopt, "prs")
+        (std::optional<double>, battery_voltage, std::nullopt, "bat")
+        (std::optional<int>, signal_strength, std::nullopt, "rssi")
+        (std::optional<std::string>, error_message, std::nullopt, "err")
+        (std::optional<std::string>, firmware_version, std::nullopt, "fw")
+        (std::string, status, "ok", "st")
+        (int, retry_count, 0, "rc")
+        (bool, calibrated, true, "cal")
+        (std::vector<std::string>, tags, {}, "tg")
+    )
+    // clang-format on
+};
+
+struct CompactBatch
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(CompactBatch,
+        (std::vector<CompactSample>, samples)
+    )
+    // clang-format on
+};
+
+// sparse as our telemetry is: most optionals are empty and most members keep their default
+static CompactBatch make_batch()
+{
+    CompactBatch batch;
+    for (int i = 0; i < 256; ++i)
+    {
+        CompactSample sample;
+        sample.device_id = "sensor-" + std::to_string(i % 16);
+        sample.timestamp = 1700000000000 + i;
+        sample.temperature = 20 + i % 7 * 0.25;
+        if (i % 4 == 0)
+            sample.humidity = 40 + i % 11;
+        if (i % 8 == 0)
+            sample.battery_voltage = 3.3;
+        if (i % 32 == 0)
+        {
+            sample.status = "degraded";
+            sample.retry_count = 2;
+            sample.error_message = "timeout while reading the pressure sensor";
+        }
+        batch.samples.push_back(std::move(sample));
+    }
+    return batch;
+}
+
+// 0 is the full output of write, 1 the compact profile with its default options, 2 also omits the default values
+static std::string write_profile(const CompactBatch &batch, int profile)
+{
+    std::string out;
+    if (profile == 0)
+        json_ext::write(batch, out);
+    else
+    {
+        json_ext::compact_options options;
+        options.omit_defaults = profile == 2;
+        json_ext::write_compact(batch, out, options);
+    }
+    return out;
+}
+
+static void BM_CompactWrite(benchmark::State &state)
+{
+    const auto batch = make_batch();
+    const auto profile = static_cast<int>(state.range(0));
+    std::string out;
+    for (auto _ : state)
+    {
+        out = write_profile(batch, profile);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["bytes"] = static_cast<double>(out.size());
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * out.size()));
+}
+BENCHMARK(BM_CompactWrite)->Arg(0)->Arg(1)->Arg(2);
+
+static void BM_CompactParse(benchmark::State &state)
+{
+    const auto input = write_profile(make_batch(), static_cast<int>(state.range(0)));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json_ext::parse_into<CompactBatch>(input));
+    state.counters["bytes"] = static_cast<double>(input.size());
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_CompactParse)->Arg(0)->Arg(1)->Arg(2);
+
+static void BM_CompactGet(benchmark::State &state)
+{
+    const auto j = nlohmann::json::parse(write_profile(make_batch(), static_cast<int>(state.range(0))));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<CompactBatch>());
+}
+BENCHMARK(BM_CompactGet)->Arg(0)->Arg(1)->Arg(2);
@@ -0,0 +1,85 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// NLOHMANN_JSON_SERIALIZE_ENUM VS NLOHMANN_SERIALIZE_ENUM
+enum class PlainCurrency
+{
+    usd,
+    eur,
+    jpy,
+    gbp,
+    chf,
+    cad,
+    aud,
+    nzd,
+    sek,
+    nok,
+    dkk,
+    pln,
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(PlainCurrency, {{PlainCurrency::usd, "usd"},
+                                             {PlainCurrency::eur, "eur"},
+                                             {PlainCurrency::jpy, "jpy"},
+                                             {PlainCurrency::gbp, "gbp"},
+                                             {PlainCurrency::chf, "chf"},
+                                             {PlainCurrency::cad, "cad"},
+                                             {PlainCurrency::aud, "aud"},
+                                             {PlainCurrency::nzd, "nzd"},
+                                             {PlainCurrency::sek, "sek"},
+                                             {PlainCurrency::nok, "nok"},
+                                             {PlainCurrency::dkk, "dkk"},
+                                             {PlainCurrency::pln, "pln"}})
+
+// clang-format off
+NLOHMANN_SERIALIZE_ENUM(ReflectedCurrency,
+    (usd)(eur)(jpy)(gbp)(chf)(cad)(aud)(nzd)(sek)(nok)(dkk)(pln)
+)
+// clang-format on
+
+template <typename Currency> static nlohmann::json make_currencies()
+{
+    std::vector<Currency> currencies;
+    for (int i = 0; i < 1024; ++i)
+        currencies.push_back(static_cast<Currency>(i % 12));
+    return currencies;
+}
+
+template <typename Currency> static void BM_EnumGet(benchmark::State &state)
+{
+    const auto j = make_currencies<Currency>();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.template get<std::vector<Currency>>());
+}
+BENCHMARK_TEMPLATE(BM_EnumGet, PlainCurrency);
+BENCHMARK_TEMPLATE(BM_EnumGet, ReflectedCurrency);
+
+template <typename Currency> static void BM_EnumToJson(benchmark::State &state)
+{
+    const auto currencies = make_currencies<Currency>().template get<std::vector<Currency>>();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(nlohmann::json(currencies));
+}
+BENCHMARK_TEMPLATE(BM_EnumToJson, PlainCurrency);
+BENCHMARK_TEMPLATE(BM_EnumToJson, ReflectedCurrency);
+
+// the enums with a direct writer, the others take the detour over to_json
+template <typename Currency> static void BM_EnumWrite(benchmark::State &state)
+{
+    const auto currencies = make_currencies<Currency>().template get<std::vector<Currency>>();
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        json_ext::write(currencies, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK_TEMPLATE(BM_EnumWrite, PlainCurrency);
+BENCHMARK_TEMPLATE(BM_EnumWrite, ReflectedCurrency);
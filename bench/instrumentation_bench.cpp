@@ -0,0 +1,57 @@
+// built as an executable of its own with JSON_EXT_INSTRUMENTATION defined, see CMakeLists.txt
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// COST OF THE INSTRUMENTATION
+struct InstrumentedTick
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(InstrumentedTick,
+        (std::string, symbol)
+        (double, price)
+        (int, size)
+    )
+    // clang-format on
+};
+
+struct InstrumentedTicks
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(InstrumentedTicks,
+        (std::vector<InstrumentedTick>, ticks)
+    )
+    // clang-format on
+};
+
+// many small objects, so the per call cost of the counters shows
+static nlohmann::json make_ticks()
+{
+    InstrumentedTicks ticks;
+    for (int i = 0; i < 256; ++i)
+        ticks.ticks.push_back({"SYM" + std::to_string(i % 16), 100.0 + i, i});
+    return ticks;
+}
+
+static void BM_InstrumentedGet(benchmark::State &state)
+{
+    const auto j = make_ticks();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<InstrumentedTicks>());
+}
+BENCHMARK(BM_InstrumentedGet);
+
+static void BM_InstrumentedGetLatency(benchmark::State &state)
+{
+    const auto j = make_ticks();
+    json_ext::instrumentation::record_latency(true);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<InstrumentedTicks>());
+    json_ext::instrumentation::record_latency(false);
+}
+BENCHMARK(BM_InstrumentedGetLatency);
@@ -0,0 +1,86 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// ROUTING ON TWO MEMBERS OF A LARGE MESSAGE
+struct LazyRoute
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(LazyRoute,
+        (std::string, topic)
+        (int, partition)
+    )
+    // clang-format on
+};
+
+struct LazyRecord
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(LazyRecord,
+        (int, id)
+        (std::string, text)
+        (std::vector<double>, values)
+    )
+    // clang-format on
+};
+
+struct LazyEnvelope
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(LazyEnvelope,
+        (LazyRoute, route)
+        (std::string, key)
+        (std::vector<LazyRecord>, records)
+    )
+    // clang-format on
+};
+
+// about 40 kB, the routing members come first as usual
+static std::string make_envelope()
+{
+    LazyEnvelope envelope{{"orders", 3}, "customer-42", {}};
+    for (int i = 0; i < 64; ++i)
+        envelope.records.push_back({i, "a record with some text " + std::to_string(i), std::vector<double>(32, i)});
+    return json_ext::dump(envelope);
+}
+
+static void BM_RouteParseGet(benchmark::State &state)
+{
+    const auto input = make_envelope();
+    for (auto _ : state)
+    {
+        const auto envelope = nlohmann::json::parse(input).get<LazyEnvelope>();
+        benchmark::DoNotOptimize(envelope.route.partition);
+        benchmark::DoNotOptimize(envelope.key.data());
+    }
+}
+BENCHMARK(BM_RouteParseGet);
+
+static void BM_RouteParseInto(benchmark::State &state)
+{
+    const auto input = make_envelope();
+    for (auto _ : state)
+    {
+        const auto envelope = json_ext::parse_into<LazyEnvelope>(input);
+        benchmark::DoNotOptimize(envelope.route.partition);
+        benchmark::DoNotOptimize(envelope.key.data());
+    }
+}
+BENCHMARK(BM_RouteParseInto);
+
+static void BM_RouteLazyView(benchmark::State &state)
+{
+    const auto input = make_envelope();
+    for (auto _ : state)
+    {
+        const json_ext::lazy_view<LazyEnvelope> view(input);
+        benchmark::DoNotOptimize(view.get<&LazyEnvelope::route>().partition);
+        benchmark::DoNotOptimize(view.get<&LazyEnvelope::key>().data());
+    }
+}
+BENCHMARK(BM_RouteLazyView);
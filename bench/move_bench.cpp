@@ -0,0 +1,81 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// COPYING VS MOVING OUT OF A DOM
+struct MoveLogRecord
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(MoveLogRecord,
+        (std::string, timestamp)
+        (std::string, host)
+        (std::string, message)
+        (std::vector<std::string>, stacktrace)
+        (std::optional<std::string>, request_id, std::nullopt)
+    )
+    // clang-format on
+};
+
+struct MoveLogBatch
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(MoveLogBatch,
+        (std::vector<MoveLogRecord>, records)
+    )
+    // clang-format on
+};
+
+// string heavy records, the strings are too long for the small string buffer
+static nlohmann::json make_batch()
+{
+    MoveLogBatch batch;
+    for (int i = 0; i < 64; ++i)
+    {
+        MoveLogRecord record{"2024-01-01T00:00:00.000000Z", "worker-" + std::to_string(i) + ".cluster.local",
+                             std::string(200, 'm'), {}, "request-" + std::to_string(i) + "-0000000000000000"};
+        for (int frame = 0; frame < 8; ++frame)
+            record.stacktrace.push_back("at some::namespace::function_" + std::to_string(frame) + "(file.cpp:42)");
+        batch.records.push_back(std::move(record));
+    }
+    return batch;
+}
+
+// both variants pay for the copy of the DOM, the copy is made by the caller in the usual "parse then get" case
+static void BM_GetCopy(benchmark::State &state)
+{
+    const auto j = make_batch();
+    for (auto _ : state)
+    {
+        auto dom = j;
+        benchmark::DoNotOptimize(dom.get<MoveLogBatch>());
+    }
+}
+BENCHMARK(BM_GetCopy);
+
+static void BM_GetMove(benchmark::State &state)
+{
+    const auto j = make_batch();
+    for (auto _ : state)
+    {
+        auto dom = j;
+        benchmark::DoNotOptimize(json_ext::get<MoveLogBatch>(std::move(dom)));
+    }
+}
+BENCHMARK(BM_GetMove);
+
+// the share of the copy of the DOM in both benchmarks above
+static void BM_GetBaseline(benchmark::State &state)
+{
+    const auto j = make_batch();
+    for (auto _ : state)
+    {
+        auto dom = j;
+        benchmark::DoNotOptimize(dom);
+    }
+}
+BENCHMARK(BM_GetBaseline);
@@ -0,0 +1,76 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <boost/preprocessor/repetition/repeat.hpp>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// FULL SNAPSHOT VS DELTA OF A WIDE STRUCT
+#define SNAPSHOT_FIELD(Z, N, _) (double, value_##N)(std::string, label_##N)
+
+// 100 members, half of them strings
+struct Snapshot
+{
+    NLOHMANN_SERIALIZE(Snapshot, BOOST_PP_REPEAT(50, SNAPSHOT_FIELD, _))
+};
+
+static Snapshot make_snapshot()
+{
+    Snapshot snapshot{};
+    snapshot.value_0 = 1.5;
+    snapshot.label_0 = "the label of the first value";
+    snapshot.value_49 = 2.5;
+    snapshot.label_49 = "the label of the last value";
+    return snapshot;
+}
+
+// a tick changes 3 of the 100 members
+static Snapshot make_tick(const Snapshot &baseline)
+{
+    auto current = baseline;
+    current.value_3 = 42;
+    current.value_17 = 43;
+    current.label_30 = "changed";
+    return current;
+}
+
+static void BM_SnapshotFull(benchmark::State &state)
+{
+    const auto current = make_tick(make_snapshot());
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        json_ext::write(current, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["bytes"] = static_cast<double>(out.size());
+}
+BENCHMARK(BM_SnapshotFull);
+
+static void BM_SnapshotDiffJson(benchmark::State &state)
+{
+    const auto baseline = make_snapshot();
+    const auto current = make_tick(baseline);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json_ext::diff(baseline, current).dump());
+}
+BENCHMARK(BM_SnapshotDiffJson);
+
+static void BM_SnapshotDiffWrite(benchmark::State &state)
+{
+    const auto baseline = make_snapshot();
+    const auto current = make_tick(baseline);
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        json_ext::write_diff(baseline, current, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["bytes"] = static_cast<double>(out.size());
+}
+BENCHMARK(BM_SnapshotDiffWrite);
@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+using nlohmann::json;
+
+////////////////////////////////////////////////////////////////////////////////
+/// DOM VS SAX DECODING
+struct SaxPoint
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(SaxPoint,
+        (double, x)
+        (double, y)
+        (std::string, label, "")
+    )
+    // clang-format on
+};
+
+struct SaxShape
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(SaxShape,
+        (int, id)
+        (std::string, name)
+        (std::optional<std::string>, comment, std::nullopt)
+        (std::vector<SaxPoint>, points)
+    )
+    // clang-format on
+};
+
+static std::string shape_text()
+{
+    SaxShape shape{1, "polygon", "closed", {}};
+    for (int i = 0; i < 64; ++i)
+        shape.points.push_back({i * 0.5, i * 1.5, "point"});
+    return static_cast<json>(shape).dump();
+}
+
+static void BM_DecodeDom(benchmark::State &state)
+{
+    const auto text = shape_text();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json::parse(text).get<SaxShape>());
+}
+BENCHMARK(BM_DecodeDom);
+
+static void BM_DecodeSax(benchmark::State &state)
+{
+    const auto text = shape_text();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json_ext::parse_into<SaxShape>(text));
+}
+BENCHMARK(BM_DecodeSax);
@@ -0,0 +1,361 @@
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+using nlohmann::json;
+
+////////////////////////////////////////////////////////////////////////////////
+/// STRICT VS NON-STRICT DECODING AND ENCODING
+struct Narrow
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(Narrow,
+        (int, field_00)
+        (int, field_01)
+        (int, field_02)
+        (int, field_03)
+    )
+    // clang-format on
+};
+
+struct NarrowStrict
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(NarrowStrict,
+        (int, field_00)
+        (int, field_01)
+        (int, field_02)
+        (int, field_03)
+    )
+    // clang-format on
+};
+
+struct Medium
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(Medium,
+        (int, field_00)
+        (int, field_01)
+        (int, field_02)
+        (int, field_03)
+        (int, field_04)
+        (int, field_05)
+        (int, field_06)
+        (int, field_07)
+        (int, field_08)
+        (int, field_09)
+        (int, field_10)
+        (int, field_11)
+        (int, field_12)
+        (int, field_13)
+        (int, field_14)
+        (int, field_15)
+    )
+    // clang-format on
+};
+
+struct MediumStrict
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(MediumStrict,
+        (int, field_00)
+        (int, field_01)
+        (int, field_02)
+        (int, field_03)
+        (int, field_04)
+        (int, field_05)
+        (int, field_06)
+        (int, field_07)
+        (int, field_08)
+        (int, field_09)
+        (int, field_10)
+        (int, field_11)
+        (int, field_12)
+        (int, field_13)
+        (int, field_14)
+        (int, field_15)
+    )
+    // clang-format on
+};
+
+struct Wide
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(Wide,
+        (int, field_00)
+        (int, field_01)
+        (int, field_02)
+        (int, field_03)
+        (int, field_04)
+        (int, field_05)
+        (int, field_06)
+        (int, field_07)
+        (int, field_08)
+        (int, field_09)
+        (int, field_10)
+        (int, field_11)
+        (int, field_12)
+        (int, field_13)
+        (int, field_14)
+        (int, field_15)
+        (int, field_16)
+        (int, field_17)
+        (int, field_18)
+        (int, field_19)
+        (int, field_20)
+        (int, field_21)
+        (int, field_22)
+        (int, field_23)
+        (int, field_24)
+        (int, field_25)
+        (int, field_26)
+        (int, field_27)
+        (int, field_28)
+        (int, field_29)
+        (int, field_30)
+        (int, field_31)
+        (int, field_32)
+        (int, field_33)
+        (int, field_34)
+        (int, field_35)
+        (int, field_36)
+        (int, field_37)
+        (int, field_38)
+        (int, field_39)
+        (int, field_40)
+        (int, field_41)
+        (int, field_42)
+        (int, field_43)
+        (int, field_44)
+        (int, field_45)
+        (int, field_46)
+        (int, field_47)
+    )
+    // clang-format on
+};
+
+struct WideStrict
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(WideStrict,
+        (int, field_00)
+        (int, field_01)
+        (int, field_02)
+        (int, field_03)
+        (int, field_04)
+        (int, field_05)
+        (int, field_06)
+        (int, field_07)
+        (int, field_08)
+        (int, field_09)
+        (int, field_10)
+        (int, field_11)
+        (int, field_12)
+        (int, field_13)
+        (int, field_14)
+        (int, field_15)
+        (int, field_16)
+        (int, field_17)
+        (int, field_18)
+        (int, field_19)
+        (int, field_20)
+        (int, field_21)
+        (int, field_22)
+        (int, field_23)
+        (int, field_24)
+        (int, field_25)
+        (int, field_26)
+        (int, field_27)
+        (int, field_28)
+        (int, field_29)
+        (int, field_30)
+        (int, field_31)
+        (int, field_32)
+        (int, field_33)
+        (int, field_34)
+        (int, field_35)
+        (int, field_36)
+        (int, field_37)
+        (int, field_38)
+        (int, field_39)
+        (int, field_40)
+        (int, field_41)
+        (int, field_42)
+        (int, field_43)
+        (int, field_44)
+        (int, field_45)
+        (int, field_46)
+        (int, field_47)
+    )
+    // clang-format on
+};
+
+template <typename T> static void BM_Decode(benchmark::State &state)
+{
+    const json j = T{};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<T>());
+    state.counters["fields"] = json_ext::detail::field_count<T>();
+}
+BENCHMARK_TEMPLATE(BM_Decode, Narrow);
+BENCHMARK_TEMPLATE(BM_Decode, NarrowStrict);
+BENCHMARK_TEMPLATE(BM_Decode, Medium);
+BENCHMARK_TEMPLATE(BM_Decode, MediumStrict);
+BENCHMARK_TEMPLATE(BM_Decode, Wide);
+BENCHMARK_TEMPLATE(BM_Decode, WideStrict);
+
+template <typename T> static void BM_Encode(benchmark::State &state)
+{
+    const T value{};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json(value));
+    state.counters["fields"] = json_ext::detail::field_count<T>();
+}
+BENCHMARK_TEMPLATE(BM_Encode, Narrow);
+BENCHMARK_TEMPLATE(BM_Encode, NarrowStrict);
+BENCHMARK_TEMPLATE(BM_Encode, Medium);
+BENCHMARK_TEMPLATE(BM_Encode, MediumStrict);
+BENCHMARK_TEMPLATE(BM_Encode, Wide);
+BENCHMARK_TEMPLATE(BM_Encode, WideStrict);
+
+////////////////////////////////////////////////////////////////////////////////
+/// OPTIONAL HEAVY
+struct Sparse
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(Sparse,
+        (int, id)
+        (std::optional<int>, count, std::nullopt)
+        (std::optional<double>, ratio, std::nullopt)
+        (std::optional<bool>, enabled, std::nullopt)
+        (std::optional<std::string>, name, std::nullopt)
+        (std::optional<std::string>, comment, std::nullopt)
+        (std::optional<std::vector<int>>, values, std::nullopt)
+        (std::optional<int>, min, std::nullopt)
+        (std::optional<int>, max, std::nullopt)
+        (std::optional<double>, scale, std::nullopt)
+        (std::optional<std::string>, unit, std::nullopt)
+        (std::optional<std::string>, owner, std::nullopt)
+    )
+    // clang-format on
+};
+
+// every other optional is set
+static Sparse make_sparse()
+{
+    Sparse sparse;
+    sparse.id = 1;
+    sparse.count = 2;
+    sparse.enabled = true;
+    sparse.comment = "comment";
+    sparse.min = 0;
+    sparse.scale = 0.5;
+    sparse.owner = "owner";
+    return sparse;
+}
+
+static void BM_DecodeOptional(benchmark::State &state)
+{
+    const json j = make_sparse();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<Sparse>());
+}
+BENCHMARK(BM_DecodeOptional);
+
+static void BM_EncodeOptional(benchmark::State &state)
+{
+    const auto sparse = make_sparse();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json(sparse));
+}
+BENCHMARK(BM_EncodeOptional);
+
+////////////////////////////////////////////////////////////////////////////////
+/// NESTED
+struct Leaf
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(Leaf,
+        (std::string, key)
+        (double, value)
+    )
+    // clang-format on
+};
+
+struct Branch
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(Branch,
+        (std::string, name)
+        (Leaf, first)
+        (std::vector<Leaf>, leaves)
+    )
+    // clang-format on
+};
+
+struct Tree
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(Tree,
+        (int, id)
+        (Branch, root)
+        (std::vector<Branch>, branches)
+    )
+    // clang-format on
+};
+
+static Tree make_tree()
+{
+    Tree tree{1, {"root", {"first", 1.0}, {}}, {}};
+    for (int i = 0; i < 8; ++i)
+    {
+        Branch branch{"branch", {"first", 1.0}, {}};
+        for (int k = 0; k < 8; ++k)
+            branch.leaves.push_back({"leaf", k * 0.5});
+        tree.branches.push_back(branch);
+    }
+    return tree;
+}
+
+static void BM_DecodeNested(benchmark::State &state)
+{
+    const json j = make_tree();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<Tree>());
+}
+BENCHMARK(BM_DecodeNested);
+
+static void BM_EncodeNested(benchmark::State &state)
+{
+    const auto tree = make_tree();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json(tree));
+}
+BENCHMARK(BM_EncodeNested);
+
+////////////////////////////////////////////////////////////////////////////////
+/// JSON LITERALS
+static void BM_JsonLiteral(benchmark::State &state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(JSON({"status" : "ok", "code" : 200, "tags" : [ "a", "b" ]}));
+}
+BENCHMARK(BM_JsonLiteral);
+
+static void BM_JsonStaticLiteral(benchmark::State &state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(JSON_STATIC({"status" : "ok", "code" : 200, "tags" : [ "a", "b" ]}));
+}
+BENCHMARK(BM_JsonStaticLiteral);
+
+static void BM_JsonStaticLiteralCopy(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        nlohmann::json copy = JSON_STATIC({"status" : "ok", "code" : 200, "tags" : [ "a", "b" ]});
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_JsonStaticLiteralCopy);
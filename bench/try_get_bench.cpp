@@ -0,0 +1,84 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// REJECTING A LARGE PAYLOAD: THROWING VS try_get
+struct TryItem
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(TryItem,
+        (int, id)
+        (std::string, name)
+        (std::vector<double>, values)
+    )
+    // clang-format on
+};
+
+struct TryPayload
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(TryPayload,
+        (std::vector<TryItem>, items)
+    )
+    // clang-format on
+};
+
+// about 1 MB of json, the rejected payload has one unknown key in its last item
+static nlohmann::json make_payload(bool valid)
+{
+    nlohmann::json items = nlohmann::json::array();
+    for (int i = 0; i < 4096; ++i)
+    {
+        const std::vector<double> values(16, i * 0.5);
+        items.push_back({{"id", i}, {"name", "item-" + std::to_string(i)}, {"values", values}});
+    }
+    if (!valid)
+        items.back()["unknown"] = true;
+    return {{"items", std::move(items)}};
+}
+
+static void BM_GetRejectThrow(benchmark::State &state)
+{
+    const auto j = make_payload(false);
+    for (auto _ : state)
+    {
+        try
+        {
+            benchmark::DoNotOptimize(j.get<TryPayload>());
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            benchmark::DoNotOptimize(e.what());
+        }
+    }
+}
+BENCHMARK(BM_GetRejectThrow);
+
+static void BM_TryGetReject(benchmark::State &state)
+{
+    const auto j = make_payload(false);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json_ext::try_get<TryPayload>(j));
+}
+BENCHMARK(BM_TryGetReject);
+
+static void BM_GetAccept(benchmark::State &state)
+{
+    const auto j = make_payload(true);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<TryPayload>());
+}
+BENCHMARK(BM_GetAccept);
+
+static void BM_TryGetAccept(benchmark::State &state)
+{
+    const auto j = make_payload(true);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json_ext::try_get<TryPayload>(j));
+}
+BENCHMARK(BM_TryGetAccept);
@@ -0,0 +1,55 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// DECODING INTO A LONG-LIVED OBJECT: get VS update
+struct UpdateBook
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(UpdateBook,
+        (std::string, symbol)
+        (std::string, venue)
+        (std::vector<double>, bids)
+        (std::vector<double>, asks)
+        (std::optional<std::string>, comment, std::nullopt)
+    )
+    // clang-format on
+};
+
+static nlohmann::json make_book()
+{
+    return {{"symbol", "SYMBOL-WITH-A-LONG-NAME-0001"},
+            {"venue", "SOME-EXCHANGE-WITH-A-LONG-NAME"},
+            {"bids", std::vector<double>(32, 1.5)},
+            {"asks", std::vector<double>(32, 2.5)},
+            {"comment", "a comment which is longer than the small string buffer"}};
+}
+
+static void BM_GetAssign(benchmark::State &state)
+{
+    const auto j = make_book();
+    UpdateBook book;
+    for (auto _ : state)
+    {
+        book = j.get<UpdateBook>();
+        benchmark::DoNotOptimize(book);
+    }
+}
+BENCHMARK(BM_GetAssign);
+
+static void BM_Update(benchmark::State &state)
+{
+    const auto j = make_book();
+    UpdateBook book;
+    for (auto _ : state)
+    {
+        json_ext::update(book, j);
+        benchmark::DoNotOptimize(book);
+    }
+}
+BENCHMARK(BM_Update);
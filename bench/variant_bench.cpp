@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <boost/preprocessor/repetition/enum.hpp>
+#include <boost/preprocessor/repetition/repeat.hpp>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+using nlohmann::json;
+
+// 20 alternatives which overlap in "id" and can only be told apart by their second key
+#define DEFINE_ALTERNATIVE(Z, N, _)                                                                                    \
+    struct Alternative##N                                                                                              \
+    {                                                                                                                  \
+        NLOHMANN_SERIALIZE_STRICT(Alternative##N, (int, id)(int, key_##N))                                             \
+    };
+
+// 20 alternatives with the same members, only the tag tells them apart
+#define DEFINE_TAGGED_ALTERNATIVE(Z, N, _)                                                                             \
+    struct TaggedAlternative##N                                                                                        \
+    {                                                                                                                  \
+        NLOHMANN_SERIALIZE_TAGGED(TaggedAlternative##N, "event_" BOOST_PP_STRINGIZE(N), (int, id)(int, value))         \
+    };
+
+#define ALTERNATIVE_NAME(Z, N, prefix) prefix##N
+
+BOOST_PP_REPEAT(20, DEFINE_ALTERNATIVE, _)
+BOOST_PP_REPEAT(20, DEFINE_TAGGED_ALTERNATIVE, _)
+
+// all alternatives are reflected, the alternative is selected by its key signature
+using SignatureVariant = std::variant<BOOST_PP_ENUM(20, ALTERNATIVE_NAME, Alternative)>;
+// the std::string prevents the key signatures, the alternatives are probed one after another
+using TrialVariant = std::variant<std::string, BOOST_PP_ENUM(20, ALTERNATIVE_NAME, Alternative)>;
+using TaggedVariant = std::variant<BOOST_PP_ENUM(20, ALTERNATIVE_NAME, TaggedAlternative)>;
+
+struct Plain
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(Plain,
+        (int, id)
+        (int, value)
+    )
+    // clang-format on
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// FIRST VS LAST ALTERNATIVE
+template <typename Variant> static void BM_DecodeVariantFirst(benchmark::State &state)
+{
+    const json j = Alternative0{1, 2};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<Variant>());
+}
+BENCHMARK_TEMPLATE(BM_DecodeVariantFirst, SignatureVariant);
+BENCHMARK_TEMPLATE(BM_DecodeVariantFirst, TrialVariant);
+
+template <typename Variant> static void BM_DecodeVariantLast(benchmark::State &state)
+{
+    const json j = Alternative19{1, 2};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<Variant>());
+}
+BENCHMARK_TEMPLATE(BM_DecodeVariantLast, SignatureVariant);
+BENCHMARK_TEMPLATE(BM_DecodeVariantLast, TrialVariant);
+
+////////////////////////////////////////////////////////////////////////////////
+/// TAGGED VARIANT VS PLAIN STRUCT
+static void BM_DecodeTaggedVariantLast(benchmark::State &state)
+{
+    const json j = TaggedAlternative19{1, 2};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<TaggedVariant>());
+}
+BENCHMARK(BM_DecodeTaggedVariantLast);
+
+static void BM_DecodePlain(benchmark::State &state)
+{
+    const json j = TaggedAlternative19{1, 2};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(j.get<Plain>());
+}
+BENCHMARK(BM_DecodePlain);
+
+static void BM_EncodeTaggedVariant(benchmark::State &state)
+{
+    const TaggedVariant value = TaggedAlternative19{1, 2};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json(value));
+}
+BENCHMARK(BM_EncodeTaggedVariant);
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+using nlohmann::json;
+
+////////////////////////////////////////////////////////////////////////////////
+/// DOM VS DIRECT ENCODING
+struct WriterPoint
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(WriterPoint,
+        (double, x)
+        (double, y)
+        (std::string, label, "")
+    )
+    // clang-format on
+};
+
+struct WriterShape
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(WriterShape,
+        (int, id)
+        (std::string, name)
+        (std::optional<std::string>, comment, std::nullopt)
+        (std::vector<WriterPoint>, points)
+    )
+    // clang-format on
+};
+
+static WriterShape make_shape()
+{
+    WriterShape shape{1, "polygon", "closed", {}};
+    for (int i = 0; i < 64; ++i)
+        shape.points.push_back({i * 0.5, i * 1.5, "point"});
+    return shape;
+}
+
+static void BM_EncodeDom(benchmark::State &state)
+{
+    const auto shape = make_shape();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(json(shape).dump());
+}
+BENCHMARK(BM_EncodeDom);
+
+static void BM_EncodeDirect(benchmark::State &state)
+{
+    const auto shape = make_shape();
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        json_ext::write(shape, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_EncodeDirect);
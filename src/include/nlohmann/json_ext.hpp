@@ -1,73 +1,5320 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <istream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 #include <variant>
 #include <vector>
 
+#include <boost/preprocessor/cat.hpp>
 #include <boost/preprocessor/facilities/is_empty_variadic.hpp>
+#include <boost/preprocessor/logical/not.hpp>
+#include <boost/preprocessor/punctuation/comma_if.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/seq/for_each_i.hpp>
 #include <boost/preprocessor/stringize.hpp>
+#include <boost/preprocessor/tuple/elem.hpp>
 
 #include <nlohmann/adl_serializer.hpp>
 #include <nlohmann/json.hpp>
 
 #define JSON(...) nlohmann::json::parse(#__VA_ARGS__)
 
+// the key which holds the tag of the types defined with NLOHMANN_SERIALIZE_TAGGED
+#ifndef JSON_EXT_TAG_KEY
+#define JSON_EXT_TAG_KEY "type"
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// JSON LITERALS
+namespace json_ext
+{
+namespace detail
+{
+// @summary constexpr syntax check of json text (RFC 8259), only used to reject invalid JSON_STATIC literals at compile
+// time, the value itself is still parsed by nlohmann::json
+class json_syntax
+{
+  public:
+    constexpr explicit json_syntax(std::string_view text) : text_(text)
+    {
+    }
+
+    constexpr bool valid()
+    {
+        skip_whitespace();
+        if (!value())
+            return false;
+
+        skip_whitespace();
+        return pos_ == text_.size();
+    }
+
+  private:
+    constexpr bool value()
+    {
+        if (pos_ == text_.size())
+            return false;
+
+        switch (text_[pos_])
+        {
+        case '{':
+            return object();
+        case '[':
+            return array();
+        case '"':
+            return string();
+        case 't':
+            return literal("true");
+        case 'f':
+            return literal("false");
+        case 'n':
+            return literal("null");
+        default:
+            return number();
+        }
+    }
+
+    constexpr bool object()
+    {
+        ++pos_;
+        skip_whitespace();
+        if (consume('}'))
+            return true;
+
+        do
+        {
+            skip_whitespace();
+            if (!peek('"') || !string())
+                return false;
+
+            skip_whitespace();
+            if (!consume(':'))
+                return false;
+
+            skip_whitespace();
+            if (!value())
+                return false;
+
+            skip_whitespace();
+        } while (consume(','));
+
+        return consume('}');
+    }
+
+    constexpr bool array()
+    {
+        ++pos_;
+        skip_whitespace();
+        if (consume(']'))
+            return true;
+
+        do
+        {
+            skip_whitespace();
+            if (!value())
+                return false;
+
+            skip_whitespace();
+        } while (consume(','));
+
+        return consume(']');
+    }
+
+    constexpr bool string()
+    {
+        ++pos_;
+        while (pos_ < text_.size())
+        {
+            const char c = text_[pos_++];
+            if (c == '"')
+                return true;
+            if (static_cast<unsigned char>(c) < 0x20)
+                return false;
+            if (c != '\\')
+                continue;
+
+            if (pos_ == text_.size())
+                return false;
+
+            const char escaped = text_[pos_++];
+            if (escaped == 'u')
+            {
+                for (int i = 0; i < 4; ++i)
+                    if (pos_ == text_.size() || !is_hex(text_[pos_++]))
+                        return false;
+            }
+            else if (std::string_view("\"\\/bfnrt").find(escaped) == std::string_view::npos)
+                return false;
+        }
+        return false;
+    }
+
+    constexpr bool number()
+    {
+        consume('-');
+        // no leading zeros
+        if (!consume('0') && !digits())
+            return false;
+
+        if (consume('.') && !digits())
+            return false;
+
+        if (consume('e') || consume('E'))
+        {
+            if (!consume('+'))
+                consume('-');
+            if (!digits())
+                return false;
+        }
+        return true;
+    }
+
+    // @summary at least one digit
+    constexpr bool digits()
+    {
+        const auto begin = pos_;
+        while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9')
+            ++pos_;
+        return pos_ != begin;
+    }
+
+    constexpr bool literal(std::string_view expected)
+    {
+        if (text_.substr(pos_, expected.size()) != expected)
+            return false;
+
+        pos_ += expected.size();
+        return true;
+    }
+
+    constexpr void skip_whitespace()
+    {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r'))
+            ++pos_;
+    }
+
+    constexpr bool peek(char c) const
+    {
+        return pos_ < text_.size() && text_[pos_] == c;
+    }
+
+    constexpr bool consume(char c)
+    {
+        if (!peek(c))
+            return false;
+
+        ++pos_;
+        return true;
+    }
+
+    static constexpr bool is_hex(char c)
+    {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    std::string_view text_;
+    std::size_t pos_ = 0;
+};
+
+constexpr bool is_valid_json(std::string_view text)
+{
+    return json_syntax(text).valid();
+}
+} // namespace detail
+} // namespace json_ext
+
+// @summary the same as JSON(...), but the text is checked at compile time and parsed only once per call site, the
+// result is an immutable reference, copy it if it has to be modified
+#define JSON_STATIC(...)                                                                                               \
+    ([]() -> const nlohmann::json & {                                                                                  \
+        static_assert(json_ext::detail::is_valid_json(#__VA_ARGS__), "JSON_STATIC: invalid json");                     \
+        static const nlohmann::json json_ext_static_json = nlohmann::json::parse(#__VA_ARGS__);                        \
+        return json_ext_static_json;                                                                                   \
+    }())
+
+////////////////////////////////////////////////////////////////////////////////
+/// INSTRUMENTATION
+namespace json_ext
+{
+namespace instrumentation
+{
+// @summary the events counted per type, see JSON_EXT_INSTRUMENTATION
+enum class counter : std::size_t
+{
+    decodes,            // calls of from_json, parse_into and parse_borrowed
+    decode_failures,    // decodes which threw
+    strict_rejections,  // unknown keys rejected by a strict type
+    alternatives_tried, // alternatives of a std::variant probed or decoded, including the one which matched
+    encodes,            // calls of to_json and write
+    decoded_bytes,      // size of the input of parse_into and parse_borrowed
+    encoded_bytes,      // size of the output of write into a std::string
+};
+
+inline constexpr std::size_t counter_count = 7;
+
+// @summary bucket i of a latency histogram counts the calls which took [2^i, 2^(i+1)) nanoseconds, the first bucket
+// also the faster and the last one also the slower calls
+inline constexpr std::size_t latency_buckets = 32;
+
+inline const char *counter_name(counter c) noexcept
+{
+    constexpr const char *names[counter_count] = {"decodes",            "decode_failures", "strict_rejections",
+                                                  "alternatives_tried", "encodes",         "decoded_bytes",
+                                                  "encoded_bytes"};
+    return names[static_cast<std::size_t>(c)];
+}
+
+// @summary the counters of one type summed over all threads at the time of the snapshot
+struct type_snapshot
+{
+    std::string_view type;
+    std::array<std::uint64_t, counter_count> counters{};
+    std::array<std::uint64_t, latency_buckets> decode_latency{};
+    std::array<std::uint64_t, latency_buckets> encode_latency{};
+
+    std::uint64_t operator[](counter c) const noexcept
+    {
+        return counters[static_cast<std::size_t>(c)];
+    }
+};
+
+namespace detail
+{
+// each thread increments one shard with relaxed atomics, the shards are on their own cache lines so threads don't
+// contend, a snapshot sums them up
+inline constexpr std::size_t shard_count = 8;
+
+struct alignas(64) shard
+{
+    // zero initialized, the counters only live in static storage
+    std::array<std::atomic<std::uint64_t>, counter_count> counters;
+    std::array<std::atomic<std::uint64_t>, latency_buckets> decode_latency;
+    std::array<std::atomic<std::uint64_t>, latency_buckets> encode_latency;
+};
+
+struct type_counters;
+
+inline std::atomic<type_counters *> &registry() noexcept
+{
+    static std::atomic<type_counters *> head{nullptr};
+    return head;
+}
+
+// @summary the counters of one type, they push themselves on the lock-free list of registry() on construction and
+// are never removed, so a snapshot can walk the list without a lock
+struct type_counters
+{
+    explicit type_counters(std::string_view type_name) noexcept
+        : type(type_name), next(registry().load(std::memory_order_relaxed))
+    {
+        while (!registry().compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    std::string_view type;
+    type_counters *next;
+    std::array<shard, shard_count> shards;
+};
+
+// @summary the name of T as the compiler prints it, e.g. "std::variant<int, Foo>"
+template <typename T> std::string_view type_name() noexcept
+{
+#if defined(__clang__) || defined(__GNUC__)
+    // "... type_name() [with T = Foo; ...]" (gcc) or "... type_name() [T = Foo]" (clang)
+    const std::string_view function = __PRETTY_FUNCTION__;
+    const auto begin = function.find("T = ") + 4;
+    const auto end = function.find_first_of(";]", begin);
+    return function.substr(begin, end - begin);
+#elif defined(_MSC_VER)
+    // "... type_name<struct Foo>(void) noexcept"
+    const std::string_view function = __FUNCSIG__;
+    const auto begin = function.find("type_name<") + 10;
+    const auto end = function.rfind(">(void)");
+    return function.substr(begin, end - begin);
+#else
+    return typeid(T).name();
+#endif
+}
+
+template <typename T> type_counters &counters_of() noexcept
+{
+    static type_counters counters(type_name<T>());
+    return counters;
+}
+
+// @summary the shard of the calling thread, the threads are distributed round robin
+inline shard &shard_of(type_counters &counters) noexcept
+{
+    static std::atomic<std::size_t> next_index{0};
+    thread_local const std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed) % shard_count;
+    return counters.shards[index];
+}
+
+inline std::atomic<bool> &latency_flag() noexcept
+{
+    static std::atomic<bool> flag{false};
+    return flag;
+}
+
+template <typename T> void count(counter c, std::uint64_t n = 1) noexcept
+{
+    shard_of(counters_of<T>()).counters[static_cast<std::size_t>(c)].fetch_add(n, std::memory_order_relaxed);
+}
+
+inline std::size_t latency_bucket(std::chrono::nanoseconds latency) noexcept
+{
+    std::size_t bucket = 0;
+    for (auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 1)); ns > 1; ns >>= 1)
+        ++bucket;
+    return std::min(bucket, latency_buckets - 1);
+}
+
+// @summary counts a call of a decode (or encode) of T on construction, its failure and latency on destruction
+template <typename T, bool is_decode> class call_scope
+{
+  public:
+    call_scope() noexcept : exceptions_(std::uncaught_exceptions())
+    {
+        count<T>(is_decode ? counter::decodes : counter::encodes);
+        if (latency_flag().load(std::memory_order_relaxed))
+            start_ = std::chrono::steady_clock::now();
+    }
+
+    call_scope(const call_scope &) = delete;
+    call_scope &operator=(const call_scope &) = delete;
+
+    ~call_scope()
+    {
+        if (is_decode && std::uncaught_exceptions() > exceptions_)
+            count<T>(counter::decode_failures);
+
+        if (start_)
+        {
+            auto &latency = is_decode ? shard_of(counters_of<T>()).decode_latency
+                                      : shard_of(counters_of<T>()).encode_latency;
+            latency[latency_bucket(std::chrono::steady_clock::now() - *start_)].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+  private:
+    int exceptions_;
+    std::optional<std::chrono::steady_clock::time_point> start_;
+};
+} // namespace detail
+
+// @summary enables or disables the latency histograms at runtime, they are off by default as they read the clock
+// twice per call. The latencies include the nested types
+inline void record_latency(bool enabled) noexcept
+{
+    detail::latency_flag().store(enabled, std::memory_order_relaxed);
+}
+
+// @summary the counters of every type which was decoded or encoded at least once. Lock-free and safe to call while
+// other threads are counting, every counter is read atomically, but not all counters at the same instant
+inline std::vector<type_snapshot> snapshot()
+{
+    std::vector<type_snapshot> result;
+    for (auto *counters = detail::registry().load(std::memory_order_acquire); counters != nullptr;
+         counters = counters->next)
+    {
+        auto &snapshot = result.emplace_back();
+        snapshot.type = counters->type;
+        for (const auto &shard : counters->shards)
+        {
+            for (std::size_t i = 0; i < counter_count; ++i)
+                snapshot.counters[i] += shard.counters[i].load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < latency_buckets; ++i)
+            {
+                snapshot.decode_latency[i] += shard.decode_latency[i].load(std::memory_order_relaxed);
+                snapshot.encode_latency[i] += shard.encode_latency[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    return result;
+}
+} // namespace instrumentation
+} // namespace json_ext
+
+// JSON_EXT_INSTRUMENTATION enables the counters of json_ext::instrumentation in the generated from_json / to_json, the
+// std::variant serializer, parse_into, parse_borrowed and write, without it the hooks expand to nothing. Define it for
+// every translation unit of the program (e.g. with target_compile_definitions), not with a #define in a source file:
+// the code generated for a type must not differ between translation units
+#ifdef JSON_EXT_INSTRUMENTATION
+#define JSON_EXT_COUNT(Type, event, n)                                                                                 \
+    json_ext::instrumentation::detail::count<Type>(json_ext::instrumentation::counter::event, n)
+#define JSON_EXT_DECODE_SCOPE(Type)                                                                                    \
+    const json_ext::instrumentation::detail::call_scope<Type, true> json_ext_instrumentation_scope
+#define JSON_EXT_ENCODE_SCOPE(Type)                                                                                    \
+    const json_ext::instrumentation::detail::call_scope<Type, false> json_ext_instrumentation_scope
+#else
+#define JSON_EXT_COUNT(Type, event, n) static_cast<void>(0)
+#define JSON_EXT_DECODE_SCOPE(Type) static_cast<void>(0)
+#define JSON_EXT_ENCODE_SCOPE(Type) static_cast<void>(0)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// REFLECTION
+namespace json_ext
+{
+namespace detail
+{
+// @summary compile time description of one reflected member, generated by NLOHMANN_SERIALIZE for every
+// (variable_type, variable_name, optional(variable_default_value), optional("alias")) tuple
+template <typename Class, typename Member, bool HasDefault, typename DefaultValue> struct field
+{
+    using class_type = Class;
+    using member_type = Member;
+    static constexpr bool has_default = HasDefault;
+
+    std::string_view name;
+    // the quoted name followed by a colon, e.g. "name": which is written in front of the value
+    std::string_view json_key;
+    // the short wire name written by the compact profile and accepted in place of name, empty if none is declared
+    std::string_view alias;
+    // the quoted alias followed by a colon
+    std::string_view json_alias_key;
+    Member Class::*member;
+    // evaluates the declared default value in the context of an object, so the default sees its other members, e.g.
+    // (int, a, 1)(int, b, a + 1). Returns nothing for required members
+    DefaultValue default_value;
+
+    // @summary assigns the declared default value to the member, the expression is evaluated on every call
+    void set_default(Class &object) const
+    {
+        static_assert(HasDefault, "only a member with a declared default can be defaulted");
+        object.*member = default_value(object);
+    }
+};
+
+template <bool HasDefault, typename Class, typename Member, typename DefaultValue>
+constexpr field<Class, Member, HasDefault, DefaultValue> make_field(std::string_view name, std::string_view json_key,
+                                                                   std::string_view alias,
+                                                                   std::string_view json_alias_key,
+                                                                   Member Class::*member, DefaultValue default_value)
+{
+    return {name, json_key, alias, json_alias_key, member, default_value};
+}
+
+template <typename T, typename = void> struct is_reflected : std::false_type
+{
+};
+
+template <typename T>
+struct is_reflected<T, std::void_t<decltype(T::json_ext_fields()), decltype(T::json_ext_strict)>> : std::true_type
+{
+};
+
+template <typename T> constexpr std::size_t field_count()
+{
+    return std::tuple_size_v<decltype(T::json_ext_fields())>;
+}
+
+template <typename T, std::size_t... Is>
+constexpr std::array<std::string_view, sizeof...(Is)> field_names(std::index_sequence<Is...>)
+{
+    constexpr auto fields = T::json_ext_fields();
+    return {std::get<Is>(fields).name...};
+}
+
+// @summary all reflected keys of T in declaration order
+template <typename T> constexpr std::array<std::string_view, field_count<T>()> field_names()
+{
+    return field_names<T>(std::make_index_sequence<field_count<T>()>{});
+}
+
+template <typename T, std::size_t... Is>
+constexpr std::array<std::string_view, sizeof...(Is)> field_aliases(std::index_sequence<Is...>)
+{
+    constexpr auto fields = T::json_ext_fields();
+    return {std::get<Is>(fields).alias...};
+}
+
+// @summary the declared aliases of T in declaration order, empty for fields without alias
+template <typename T> constexpr std::array<std::string_view, field_count<T>()> field_aliases()
+{
+    return field_aliases<T>(std::make_index_sequence<field_count<T>()>{});
+}
+
+template <typename T> constexpr std::size_t alias_count()
+{
+    std::size_t count = 0;
+    for (auto alias : field_aliases<T>())
+        count += !alias.empty();
+    return count;
+}
+
+template <typename T, typename = void> struct is_tagged : std::false_type
+{
+};
+
+template <typename T> struct is_tagged<T, std::void_t<decltype(T::json_ext_tag)>> : std::true_type
+{
+};
+
+constexpr std::string_view tag_key = JSON_EXT_TAG_KEY;
+constexpr std::string_view tag_json_key = "\"" JSON_EXT_TAG_KEY "\":";
+
+// @summary whether no member of T is named or aliased as the tag key, else the writers would write the key twice and
+// the decoders would read the member from the tag
+template <typename T> constexpr bool tag_key_is_free()
+{
+    if constexpr (is_tagged<T>::value)
+    {
+        for (auto name : field_names<T>())
+            if (name == tag_key)
+                return false;
+        for (auto alias : field_aliases<T>())
+            if (alias == tag_key)
+                return false;
+    }
+    return true;
+}
+
+template <typename T> constexpr std::size_t key_count()
+{
+    return field_count<T>() + is_tagged<T>::value;
+}
+
+// @summary all keys T accepts, the reflected keys in declaration order followed by the tag key if T is tagged, so the
+// tag key has the index field_count<T>()
+template <typename T> constexpr std::array<std::string_view, key_count<T>()> key_names()
+{
+    static_assert(tag_key_is_free<T>(), "a member of a tagged type can't be named or aliased as JSON_EXT_TAG_KEY");
+
+    std::array<std::string_view, key_count<T>()> keys{};
+    const auto names = field_names<T>();
+    for (std::size_t i = 0; i < names.size(); ++i)
+        keys[i] = names[i];
+
+    if constexpr (is_tagged<T>::value)
+        keys[field_count<T>()] = tag_key;
+    return keys;
+}
+
+template <typename T, typename BasicJsonType> bool has_matching_tag(const BasicJsonType &tag)
+{
+    return tag.is_string() && tag.template get_ref<const typename BasicJsonType::string_t &>() == T::json_ext_tag;
+}
+
+[[noreturn]] inline void throw_tag_mismatch(std::string_view expected, std::string_view actual)
+{
+    throw nlohmann::detail::other_error::create(602,
+                                                nlohmann::detail::concat("expected " JSON_EXT_TAG_KEY " '",
+                                                                         std::string(expected), "' but got: ",
+                                                                         std::string(actual)),
+                                                nullptr);
+}
+
+// @summary tagged types also accept json without the tag, but if the tag is present it has to match
+template <typename T, typename BasicJsonType> void from_json_tag(const BasicJsonType &j)
+{
+    static_assert(tag_key_is_free<T>(), "a member of a tagged type can't be named or aliased as JSON_EXT_TAG_KEY");
+
+    if constexpr (is_tagged<T>::value)
+    {
+        if (!j.is_object())
+            return;
+
+        const auto it = j.find(tag_key);
+        if (it != j.end() && !has_matching_tag<T>(*it))
+            throw_tag_mismatch(T::json_ext_tag, it->dump());
+    }
+}
+
+template <typename T, typename BasicJsonType> void to_json_tag(BasicJsonType &j)
+{
+    static_assert(tag_key_is_free<T>(), "a member of a tagged type can't be named or aliased as JSON_EXT_TAG_KEY");
+
+    if constexpr (is_tagged<T>::value)
+        j[JSON_EXT_TAG_KEY] = T::json_ext_tag;
+}
+
+constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+// @summary fixed capacity set of keys, which can be filled at compile time
+template <std::size_t N> struct key_set
+{
+    std::array<std::string_view, N> keys{};
+    std::size_t size = 0;
+
+    constexpr std::size_t find(std::string_view key) const
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            if (keys[i] == key)
+                return i;
+
+        return npos;
+    }
+
+    constexpr void insert(std::string_view key)
+    {
+        if (find(key) == npos)
+            keys[size++] = key;
+    }
+};
+
+constexpr std::uint64_t hash_key(std::string_view key)
+{
+    // FNV-1a
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : key)
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    return hash;
+}
+
+constexpr std::size_t key_table_capacity(std::size_t keys)
+{
+    // at most half full, so a lookup almost always resolves in the first slot
+    std::size_t capacity = 1;
+    while (capacity < 2 * keys)
+        capacity *= 2;
+    return capacity;
+}
+
+// @summary open addressing hash table over a key_set which is built at compile time, a lookup hashes the key once and
+// compares strings only if the full 64 bit hash matches
+template <std::size_t N> struct key_table
+{
+    static constexpr std::size_t capacity = key_table_capacity(N);
+
+    key_set<N> set{};
+    std::array<std::uint64_t, capacity> hashes{};
+    // index + 1 into the key_set, 0 marks an empty slot
+    std::array<std::size_t, capacity> slots{};
+
+    constexpr explicit key_table(const key_set<N> &keys) : set(keys)
+    {
+        for (std::size_t i = 0; i < set.size; ++i)
+        {
+            const auto hash = hash_key(set.keys[i]);
+            auto slot = hash & (capacity - 1);
+            while (slots[slot] != 0)
+                slot = (slot + 1) & (capacity - 1);
+
+            hashes[slot] = hash;
+            slots[slot] = i + 1;
+        }
+    }
+
+    constexpr std::size_t find(std::string_view key) const
+    {
+        const auto hash = hash_key(key);
+        for (auto slot = hash & (capacity - 1); slots[slot] != 0; slot = (slot + 1) & (capacity - 1))
+            if (hashes[slot] == hash && set.keys[slots[slot] - 1] == key)
+                return slots[slot] - 1;
+
+        return npos;
+    }
+
+    constexpr std::size_t size() const
+    {
+        return set.size;
+    }
+};
+
+template <std::size_t N> constexpr key_table<N> make_key_table(const std::array<std::string_view, N> &keys)
+{
+    key_set<N> set;
+    for (auto key : keys)
+        set.insert(key);
+    return key_table<N>(set);
+}
+
+// @summary the compile time hash table of the declared aliases of T, field[i] is the index of the field of alias i
+template <typename T> struct alias_table
+{
+    static constexpr std::size_t size = alias_count<T>();
+
+    static constexpr std::array<std::string_view, size> aliases = [] {
+        std::array<std::string_view, size> aliases{};
+        std::size_t count = 0;
+        for (auto alias : field_aliases<T>())
+            if (!alias.empty())
+                aliases[count++] = alias;
+        return aliases;
+    }();
+
+    static constexpr std::array<std::size_t, size> field = [] {
+        std::array<std::size_t, size> field{};
+        std::size_t count = 0;
+        const auto all = field_aliases<T>();
+        for (std::size_t i = 0; i < all.size(); ++i)
+            if (!all[i].empty())
+                field[count++] = i;
+        return field;
+    }();
+
+    static constexpr auto keys = make_key_table(aliases);
+    static_assert(keys.size() == size, "the aliases of a type have to be unique");
+    static_assert(
+        [] {
+            const auto names = make_key_table(key_names<T>());
+            for (auto alias : aliases)
+                if (names.find(alias) != npos)
+                    return false;
+            return true;
+        }(),
+        "an alias may not be the name of another field or the tag key");
+};
+
+// @summary lookup of the index of a reflected key of T (see key_names), npos if T doesn't reflect the key. A declared
+// alias resolves to the index of its field, is_alias tells if it did
+template <typename T> std::size_t field_index(std::string_view key, bool &is_alias)
+{
+    static constexpr auto possible_keys = make_key_table(key_names<T>());
+    const auto index = possible_keys.find(key);
+    is_alias = false;
+    if constexpr (alias_count<T>() > 0)
+    {
+        if (index == npos)
+        {
+            const auto alias = alias_table<T>::keys.find(key);
+            if (alias == npos)
+                return npos;
+            is_alias = true;
+            return alias_table<T>::field[alias];
+        }
+    }
+    return index;
+}
+
+template <typename T> std::size_t field_index(std::string_view key)
+{
+    bool is_alias;
+    return field_index<T>(key, is_alias);
+}
+
+// @summary decides which key of an object gives the value of a field: the name wins over the alias wherever they
+// appear, as with from_json which looks the alias up only if the name is missing. Among duplicates of the same key the
+// last one wins as with nlohmann::json
+template <typename T> class key_precedence
+{
+  public:
+    // false if the value of the key has to be skipped as the name of its field was already seen
+    bool accept(std::size_t index, bool is_alias)
+    {
+        if constexpr (alias_count<T>() == 0)
+            return true;
+        else
+        {
+            if (index >= field_count<T>())
+                return true;
+            if (!is_alias)
+                by_name_.set(index);
+            return !is_alias || !by_name_.test(index);
+        }
+    }
+
+  private:
+    std::bitset<alias_count<T>() == 0 ? 0 : field_count<T>()> by_name_;
+};
+} // namespace detail
+
+enum class decode_errc
+{
+    // the json has the wrong type, e.g. a number where a string is expected
+    type_mismatch,
+    // a member without default value is missing
+    missing_key,
+    // a strict type got a key it doesn't reflect
+    unknown_key,
+    // the tag of a tagged type doesn't match
+    tag_mismatch,
+    // no alternative of a variant matches
+    no_matching_variant,
+    // the from_json of a type we can't reason about threw
+    conversion_failed,
+    // the json doesn't name an enumerator of an enum defined with NLOHMANN_SERIALIZE_ENUM
+    unknown_enumerator,
+};
+
+// @summary describes why a json can't be converted, nothing is formatted until pointer() or message() is called
+struct decode_error
+{
+    decode_errc code = decode_errc::type_mismatch;
+    // the missing, unknown or tag key, the dumped json of an unknown enumerator
+    std::string key;
+    // the expected json type, tag or enum, actual is the json type found, both point to string literals
+    std::string_view expected;
+    std::string_view actual;
+    // the message of the exception for conversion_failed
+    std::string what;
+    // the reference tokens from the failing value up to the root, they are collected while unwinding
+    std::vector<std::string> reversed_path;
+
+    // @summary the location of the failing value, for a missing key the location it is expected at
+    nlohmann::json::json_pointer pointer() const
+    {
+        nlohmann::json::json_pointer pointer;
+        for (auto it = reversed_path.rbegin(); it != reversed_path.rend(); ++it)
+            pointer /= *it;
+        return pointer;
+    }
+
+    std::string message() const
+    {
+        std::string message = pointer().to_string();
+        message += message.empty() ? "" : ": ";
+        switch (code)
+        {
+        case decode_errc::type_mismatch:
+            return nlohmann::detail::concat(message, "type must be ", expected, ", but is ", actual);
+        case decode_errc::missing_key:
+            return nlohmann::detail::concat(message, "key '", key, "' not found");
+        case decode_errc::unknown_key:
+            return nlohmann::detail::concat(message, "key '", key, "' not present in reflected keys");
+        case decode_errc::tag_mismatch:
+            return nlohmann::detail::concat(message, "expected ", key, " '", expected, "'");
+        case decode_errc::no_matching_variant:
+            return nlohmann::detail::concat(message, "unable to find matching variant for ", actual);
+        case decode_errc::conversion_failed:
+            return nlohmann::detail::concat(message, what);
+        case decode_errc::unknown_enumerator:
+            return nlohmann::detail::concat(message, "no enumerator of ", expected, " for: ", key);
+        }
+        return message;
+    }
+};
+
+namespace detail
+{
+// @summary records the failure if error isn't null, always returns false so probes can `return fail(...)`
+template <typename BasicJsonType>
+bool fail(decode_error *error, decode_errc code, const BasicJsonType &j, std::string_view expected = {},
+          std::string_view key = {})
+{
+    if (error != nullptr)
+    {
+        error->code = code;
+        error->key = key;
+        error->expected = expected;
+        error->actual = j.type_name();
+    }
+    return false;
+}
+
+// @summary adds the location of a failing child while unwinding, always returns false
+inline bool fail_at(decode_error *error, std::string_view token)
+{
+    if (error != nullptr)
+        error->reversed_path.emplace_back(token);
+    return false;
+}
+
+inline bool fail_at(decode_error *error, std::size_t index)
+{
+    if (error != nullptr)
+        error->reversed_path.push_back(std::to_string(index));
+    return false;
+}
+} // namespace detail
+
+// @summary checks without throwing whether j.get<T>() would succeed, the default covers every type we can't reason
+// about (e.g. types with a custom from_json) by trying the conversion. If error isn't null the reason of a failure is
+// written to it
+template <typename T, typename = void> struct probe
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &j, decode_error *error = nullptr)
+    {
+        try
+        {
+            j.template get<T>();
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            if (error != nullptr)
+            {
+                error->code = decode_errc::conversion_failed;
+                error->what = e.what();
+            }
+            return false;
+        }
+        catch (...)
+        {
+            // a from_json may throw anything, can_parse is noexcept
+            if (error != nullptr)
+            {
+                error->code = decode_errc::conversion_failed;
+                error->what = "unknown exception";
+            }
+            return false;
+        }
+    }
+};
+
+template <typename T, typename BasicJsonType> bool can_parse(const BasicJsonType &j) noexcept
+{
+    return probe<T>::can_parse(j);
+}
+
+// @summary the same as can_parse, but writes the reason of a failure to error
+template <typename T, typename BasicJsonType> bool can_parse(const BasicJsonType &j, decode_error &error)
+{
+    return probe<T>::can_parse(j, &error);
+}
+
+template <typename T> struct probe<T, std::enable_if_t<nlohmann::detail::is_basic_json<T>::value>>
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &, decode_error * = nullptr)
+    {
+        return true;
+    }
+};
+
+template <> struct probe<std::nullptr_t>
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &j, decode_error *error = nullptr)
+    {
+        return j.is_null() || detail::fail(error, decode_errc::type_mismatch, j, "null");
+    }
+};
+
+template <> struct probe<bool>
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &j, decode_error *error = nullptr)
+    {
+        return j.is_boolean() || detail::fail(error, decode_errc::type_mismatch, j, "boolean");
+    }
+};
+
+template <> struct probe<std::string>
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &j, decode_error *error = nullptr)
+    {
+        return j.is_string() || detail::fail(error, decode_errc::type_mismatch, j, "string");
+    }
+};
+
+template <typename T>
+struct probe<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>>
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &j, decode_error *error = nullptr)
+    {
+        // nlohmann converts booleans to every arithmetic type except its own number types
+        constexpr bool accepts_boolean = !std::is_same_v<T, typename BasicJsonType::number_integer_t> &&
+                                         !std::is_same_v<T, typename BasicJsonType::number_unsigned_t> &&
+                                         !std::is_same_v<T, typename BasicJsonType::number_float_t>;
+        return j.is_number() || (accepts_boolean && j.is_boolean()) ||
+               detail::fail(error, decode_errc::type_mismatch, j, "number");
+    }
+};
+
+template <typename T> struct probe<std::optional<T>>
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &j, decode_error *error = nullptr)
+    {
+        return j.is_null() || probe<T>::can_parse(j, error);
+    }
+};
+
+template <typename... Ts> struct probe<std::variant<Ts...>>
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &j, decode_error *error = nullptr)
+    {
+        // if all alternatives are tagged and j has a known tag only this alternative is parsed, so its error is
+        // reported
+        if constexpr ((detail::is_tagged<Ts>::value && ...))
+        {
+            if (error != nullptr && j.is_object())
+            {
+                const auto it = j.find(detail::tag_key);
+                if (it != j.end() && it->is_string())
+                {
+                    constexpr std::array<std::string_view, sizeof...(Ts)> tags = {Ts::json_ext_tag...};
+                    constexpr std::array<bool (*)(const BasicJsonType &, decode_error *), sizeof...(Ts)> probes = {
+                        &probe<Ts>::template can_parse<BasicJsonType>...};
+
+                    const auto &tag = it->template get_ref<const typename BasicJsonType::string_t &>();
+                    for (std::size_t i = 0; i < tags.size(); ++i)
+                        if (tags[i] == tag)
+                            return probes[i](j, error);
+                }
+            }
+        }
+
+        return (json_ext::can_parse<Ts>(j) || ...) || detail::fail(error, decode_errc::no_matching_variant, j);
+    }
+};
+
+template <typename T, typename Allocator> struct probe<std::vector<T, Allocator>>
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &j, decode_error *error = nullptr)
+    {
+        if (!j.is_array())
+            return detail::fail(error, decode_errc::type_mismatch, j, "array");
+
+        for (std::size_t i = 0; i < j.size(); ++i)
+            if (!probe<T>::can_parse(j[i], error))
+                return detail::fail_at(error, i);
+
+        return true;
+    }
+};
+
+template <typename T> struct probe<T, std::enable_if_t<detail::is_reflected<T>::value>>
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &j, decode_error *error = nullptr)
+    {
+        if (!j.is_object())
+            return detail::fail(error, decode_errc::type_mismatch, j, "object");
+
+        if constexpr (T::json_ext_strict)
+        {
+            for (auto it = j.begin(); it != j.end(); ++it)
+                if (detail::field_index<T>(it.key()) == detail::npos)
+                    return detail::fail(error, decode_errc::unknown_key, *it, {}, it.key()) ||
+                           detail::fail_at(error, it.key());
+        }
+
+        if constexpr (detail::is_tagged<T>::value)
+        {
+            const auto it = j.find(detail::tag_key);
+            if (it != j.end() && !detail::has_matching_tag<T>(*it))
+                return detail::fail(error, decode_errc::tag_mismatch, *it, T::json_ext_tag, detail::tag_key) ||
+                       detail::fail_at(error, detail::tag_key);
+        }
+
+        return std::apply([&](const auto &...fields) { return (can_parse_field(j, fields, error) && ...); },
+                          T::json_ext_fields());
+    }
+
+  private:
+    template <typename BasicJsonType, typename Field>
+    static bool can_parse_field(const BasicJsonType &j, const Field &field, decode_error *error)
+    {
+        auto it = j.find(field.name);
+        if (it == j.end() && !field.alias.empty())
+            it = j.find(field.alias);
+        if (it == j.end())
+            return Field::has_default || detail::fail(error, decode_errc::missing_key, j, {}, field.name) ||
+                   detail::fail_at(error, field.name);
+
+        return probe<typename Field::member_type>::can_parse(*it, error) || detail::fail_at(error, field.name);
+    }
+};
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// ENUM REFLECTION
+namespace json_ext
+{
+namespace detail
+{
+// @summary what NLOHMANN_SERIALIZE_ENUM declares about an enum, the json names are in the order of the enumerators, so
+// the value of an enumerator is the index of its name
+template <std::size_t N> struct enum_reflection
+{
+    std::string_view type;
+    bool as_integer;
+    std::array<std::string_view, N> names;
+};
+
+template <std::size_t N>
+constexpr enum_reflection<N> make_enum_reflection(std::string_view type, bool as_integer,
+                                                  const std::array<std::string_view, N> &names)
+{
+    return {type, as_integer, names};
+}
+
+// the generated json_ext_enum is found by argument dependent lookup
+template <typename T, typename = void> struct is_reflected_enum : std::false_type
+{
+};
+
+template <typename T>
+struct is_reflected_enum<T, std::void_t<decltype(json_ext_enum(std::declval<T>()))>> : std::is_enum<T>
+{
+};
+
+// @summary the constexpr tables of an enum: the names by value and the compile time hash table of the names
+template <typename T> struct enum_table
+{
+    static constexpr auto reflection = json_ext_enum(T{});
+    static constexpr auto names = make_key_table(reflection.names);
+    static_assert(names.size() == reflection.names.size(), "the json names of the enumerators have to be unique");
+};
+
+
+template <typename T> [[noreturn]] void throw_unknown_enumerator(const std::string &dumped)
+{
+    throw nlohmann::detail::other_error::create(
+        603, nlohmann::detail::concat("no enumerator of ", enum_table<T>::reflection.type, " for: ", dumped), nullptr);
+}
+
+// @summary the index of value into the names, throws for a value which isn't a declared enumerator (e.g. a cast
+// integer)
+template <typename T> std::size_t enumerator_index(T value)
+{
+    const auto index = static_cast<std::underlying_type_t<T>>(value);
+    if (index < 0 || static_cast<std::size_t>(index) >= enum_table<T>::reflection.names.size())
+        throw_unknown_enumerator<T>(std::to_string(index));
+    return static_cast<std::size_t>(index);
+}
+
+template <typename T> std::string_view enumerator_name(T value)
+{
+    return enum_table<T>::reflection.names[enumerator_index(value)];
+}
+
+// @summary the json type the enumerators are written as
+template <typename T> constexpr const char *enum_json_type()
+{
+    return enum_table<T>::reflection.as_integer ? "number" : "string";
+}
+
+template <typename T, typename BasicJsonType> bool has_enum_json_type(const BasicJsonType &j)
+{
+    return enum_table<T>::reflection.as_integer ? j.is_number() : j.is_string();
+}
+
+// @summary the index of the enumerator j stands for, its name or for enums written as integers its value. npos if j
+// stands for no enumerator
+template <typename T, typename BasicJsonType> std::size_t find_enumerator(const BasicJsonType &j)
+{
+    using table = enum_table<T>;
+    if constexpr (table::reflection.as_integer)
+    {
+        if (!j.is_number_integer())
+            return npos;
+
+        const auto index = j.template get<typename BasicJsonType::number_integer_t>();
+        return index >= 0 && static_cast<std::size_t>(index) < table::reflection.names.size()
+                   ? static_cast<std::size_t>(index)
+                   : npos;
+    }
+    else
+    {
+        if (!j.is_string())
+            return npos;
+
+        const auto &name = j.template get_ref<const typename BasicJsonType::string_t &>();
+        return table::names.find(std::string_view(name.data(), name.size()));
+    }
+}
+
+template <typename BasicJsonType, typename T> void enum_to_json(BasicJsonType &j, T value)
+{
+    if constexpr (enum_table<T>::reflection.as_integer)
+        j = static_cast<typename BasicJsonType::number_integer_t>(enumerator_index(value));
+    else
+        j = enumerator_name(value);
+}
+
+template <typename BasicJsonType, typename T> void enum_from_json(const BasicJsonType &j, T &value)
+{
+    const auto index = find_enumerator<T>(j);
+    if (index != npos)
+        value = static_cast<T>(index);
+    else if (has_enum_json_type<T>(j))
+        throw nlohmann::detail::other_error::create(
+            603, nlohmann::detail::concat("no enumerator of ", enum_table<T>::reflection.type, " for: ", j.dump()),
+            &j);
+    else
+        throw nlohmann::detail::type_error::create(
+            302, nlohmann::detail::concat("type must be ", enum_json_type<T>(), ", but is ", j.type_name()), &j);
+}
+} // namespace detail
+
+template <typename T> struct probe<T, std::enable_if_t<detail::is_reflected_enum<T>::value>>
+{
+    template <typename BasicJsonType> static bool can_parse(const BasicJsonType &j, decode_error *error = nullptr)
+    {
+        if (detail::find_enumerator<T>(j) != detail::npos)
+            return true;
+        if (!detail::has_enum_json_type<T>(j))
+            return detail::fail(error, decode_errc::type_mismatch, j, detail::enum_json_type<T>());
+        // the value is only dumped if the error is asked for
+        return error != nullptr && detail::fail(error, decode_errc::unknown_enumerator, j,
+                                                detail::enum_table<T>::reflection.type, j.dump());
+    }
+};
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// IN-PLACE AND MOVING DESERIALIZATION
+namespace json_ext
+{
+namespace detail
+{
+// @summary describes how j is converted into an existing value. The members, elements and alternatives of value are
+// assigned in place, so strings and vectors keep their capacity. If j is not const it isn't needed anymore and its
+// strings, binaries and arrays are moved instead of copied. The default does what j.get_to(value) does
+template <typename T, typename = void> struct json_extractor
+{
+    template <typename BasicJsonType> static void extract(BasicJsonType &j, T &value)
+    {
+        j.get_to(value);
+    }
+};
+
+// @summary converts j into value, if j isn't const it is left in a valid but unspecified state
+template <typename BasicJsonType, typename T> void extract(BasicJsonType &j, T &value)
+{
+    json_extractor<T>::extract(j, value);
+}
+
+template <typename Like, typename T> using const_like_t = std::conditional_t<std::is_const_v<Like>, const T, T>;
+
+// @summary the same as j.get<T>(), but moves if j isn't const
+template <typename T, typename BasicJsonType> T take(BasicJsonType &j)
+{
+    if constexpr (std::is_const_v<BasicJsonType> || !std::is_default_constructible_v<T>)
+        return j.template get<T>();
+    else
+    {
+        T value;
+        json_ext::detail::extract(j, value);
+        return value;
+    }
+}
+
+template <> struct json_extractor<std::string>
+{
+    template <typename BasicJsonType> static void extract(BasicJsonType &j, std::string &value)
+    {
+        // a copy is assigned by get_to, which keeps the capacity of value
+        if constexpr (!std::is_const_v<BasicJsonType> && std::is_same_v<typename BasicJsonType::string_t, std::string>)
+        {
+            if (j.is_string())
+            {
+                value = std::move(j.template get_ref<std::string &>());
+                return;
+            }
+        }
+        j.get_to(value);
+    }
+};
+
+template <typename BinaryType> struct json_extractor<nlohmann::byte_container_with_subtype<BinaryType>>
+{
+    template <typename BasicJsonType>
+    static void extract(BasicJsonType &j, nlohmann::byte_container_with_subtype<BinaryType> &value)
+    {
+        using binary_type = nlohmann::byte_container_with_subtype<BinaryType>;
+        if constexpr (!std::is_const_v<BasicJsonType> && std::is_same_v<typename BasicJsonType::binary_t, binary_type>)
+        {
+            if (j.is_binary())
+            {
+                value = std::move(j.get_binary());
+                return;
+            }
+        }
+        j.get_to(value);
+    }
+};
+
+template <typename T>
+struct json_extractor<T, std::enable_if_t<nlohmann::detail::is_basic_json<T>::value>>
+{
+    template <typename BasicJsonType> static void extract(BasicJsonType &j, T &value)
+    {
+        if constexpr (std::is_same_v<BasicJsonType, T>)
+            value = std::move(j);
+        else
+            value = j;
+    }
+};
+
+template <typename T, typename Allocator>
+struct json_extractor<std::vector<T, Allocator>,
+                      std::enable_if_t<!std::is_same_v<T, bool> && std::is_default_constructible_v<T>>>
+{
+    template <typename BasicJsonType> static void extract(BasicJsonType &j, std::vector<T, Allocator> &value)
+    {
+        // let nlohmann::json throw the same error as for a copy
+        if (!j.is_array())
+        {
+            j.get_to(value);
+            return;
+        }
+
+        // the elements which are kept are assigned in place
+        auto &elements = j.template get_ref<const_like_t<BasicJsonType, typename BasicJsonType::array_t> &>();
+        value.resize(elements.size());
+        for (std::size_t i = 0; i < elements.size(); ++i)
+            json_ext::detail::extract(elements[i], value[i]);
+    }
+};
+
+template <typename T> struct json_extractor<std::optional<T>>
+{
+    template <typename BasicJsonType> static void extract(BasicJsonType &j, std::optional<T> &value)
+    {
+        if constexpr (std::is_const_v<BasicJsonType>)
+            nlohmann::adl_serializer<std::optional<T>>::from_json(j, value);
+        else
+            nlohmann::adl_serializer<std::optional<T>>::from_json(std::move(j), value);
+    }
+};
+
+template <typename... Ts> struct json_extractor<std::variant<Ts...>>
+{
+    template <typename BasicJsonType> static void extract(BasicJsonType &j, std::variant<Ts...> &value)
+    {
+        if constexpr (std::is_const_v<BasicJsonType>)
+            nlohmann::adl_serializer<std::variant<Ts...>>::from_json(j, value);
+        else
+            nlohmann::adl_serializer<std::variant<Ts...>>::from_json(std::move(j), value);
+    }
+};
+
+template <typename T> struct json_extractor<T, std::enable_if_t<is_reflected<T>::value>>
+{
+    template <typename BasicJsonType> static void extract(BasicJsonType &j, T &value)
+    {
+        // the from_json generated by the macros assigns the members in place
+        if constexpr (std::is_const_v<BasicJsonType>)
+            from_json(j, value);
+        else
+            from_json(std::move(j), value);
+    }
+};
+
+// @summary the same as j.at(key).get_to(value), but moves if j isn't const. If key is missing the declared alias of the
+// member is used instead, the error still names the key
+template <typename BasicJsonType, typename T>
+void get_required(BasicJsonType &j, const char *key, std::string_view alias, T &value)
+{
+    if (!alias.empty() && j.is_object() && j.find(key) == j.end())
+    {
+        const auto it = j.find(alias);
+        if (it != j.end())
+        {
+            json_ext::detail::extract(*it, value);
+            return;
+        }
+    }
+
+    json_ext::detail::extract(j.at(key), value);
+}
+
+// @summary same as nlohmann_json_j.value(key, default) without the need of a default object, if neither the key nor
+// its alias is present nothing happens and false is returned, so the caller can assign the default value. Moves if j
+// isn't const
+template <typename BasicJsonType, typename T>
+bool get_if_present(BasicJsonType &j, const char *key, std::string_view alias, T &value)
+{
+    if (!j.is_object())
+        throw nlohmann::detail::type_error::create(
+            306, nlohmann::detail::concat("cannot use value() with ", j.type_name()), &j);
+
+    auto it = j.find(key);
+    if (it == j.end() && !alias.empty())
+        it = j.find(alias);
+    if (it == j.end())
+        return false;
+
+    json_ext::detail::extract(*it, value);
+    return true;
+}
+
+// @summary the members of value one after the other as the generated from_json of non-strict types decodes them
+template <typename T, typename BasicJsonType> void get_fields(BasicJsonType &j, T &value)
+{
+    std::apply(
+        [&](const auto &...fields) {
+            (
+                [&](const auto &field) {
+                    if constexpr (std::remove_reference_t<decltype(field)>::has_default)
+                    {
+                        if (!get_if_present(j, field.name.data(), field.alias, value.*(field.member)))
+                            field.set_default(value);
+                    }
+                    else
+                        get_required(j, field.name.data(), field.alias, value.*(field.member));
+                }(fields),
+                ...);
+        },
+        T::json_ext_fields());
+}
+
+// @summary names the key instead of dumping j, which may be the whole document. With JSON_DIAGNOSTICS the exception
+// starts with the json pointer of j, try_get returns it as decode_error::pointer
+template <typename T, typename BasicJsonType>
+[[noreturn]] void throw_unknown_key(const BasicJsonType &j, std::string_view key)
+{
+    JSON_EXT_COUNT(T, strict_rejections, 1);
+    throw nlohmann::detail::other_error::create(
+        600, nlohmann::detail::concat("key '", std::string(key), "' not present in reflected keys"), &j);
+}
+
+// @summary the from_json of strict types. Every key of j is looked up once in the key table of T (see field_index),
+// which rejects the unknown keys before any member is decoded and remembers the value of every member, so the members
+// are decoded without looking them up in j again. Throws the same as the non-strict from_json for valid keys
+template <typename T, typename BasicJsonType> void from_json_strict(BasicJsonType &j, T &value)
+{
+    if (!j.is_object())
+    {
+        // an array has its indices as keys, so it is rejected if it isn't empty, everything else throws as from_json
+        for (const auto &item : j.items())
+            throw_unknown_key<T>(j, item.key());
+        get_fields(j, value);
+        return;
+    }
+
+    using value_pointer = std::conditional_t<std::is_const_v<BasicJsonType>, const std::remove_const_t<BasicJsonType> *,
+                                             BasicJsonType *>;
+    std::array<value_pointer, key_count<T>()> values{};
+    key_precedence<T> precedence;
+    for (auto it = j.begin(); it != j.end(); ++it)
+    {
+        bool is_alias;
+        const auto index = field_index<T>(it.key(), is_alias);
+        if (index == npos)
+            throw_unknown_key<T>(j, it.key());
+        if (precedence.accept(index, is_alias))
+            values[index] = &*it;
+    }
+
+    if constexpr (is_tagged<T>::value)
+    {
+        const auto *tag = values[field_count<T>()];
+        if (tag != nullptr && !has_matching_tag<T>(*tag))
+            throw_tag_mismatch(T::json_ext_tag, tag->dump());
+    }
+
+    std::apply(
+        [&](const auto &...fields) {
+            std::size_t i = 0;
+            (
+                [&](const auto &field, auto *member_value) {
+                    if (member_value != nullptr)
+                        extract(*member_value, value.*(field.member));
+                    else if constexpr (std::remove_reference_t<decltype(field)>::has_default)
+                        field.set_default(value);
+                    else
+                        throw nlohmann::detail::out_of_range::create(
+                            403, nlohmann::detail::concat("key '", std::string(field.name), "' not found"), &j);
+                }(fields, values[i++]),
+                ...);
+        },
+        T::json_ext_fields());
+}
+} // namespace detail
+
+// @summary decodes j into the existing value instead of a new one: the members of reflected types, the elements of
+// vectors, the value of an optional and the alternative of a variant (if it stays the same) are assigned in place, so
+// their strings and vectors keep their capacity. Members missing in j get their default values as with j.get<T>(). If
+// j is an rvalue its strings, binaries and arrays are moved into value. If an exception is thrown value is left in a
+// valid but unspecified state
+template <typename T, typename BasicJsonType> void update(T &value, BasicJsonType &&j)
+{
+    static_assert(nlohmann::detail::is_basic_json<std::decay_t<BasicJsonType>>::value);
+
+    // only an rvalue may be moved from
+    if constexpr (std::is_lvalue_reference_v<BasicJsonType>)
+        detail::extract(std::as_const(j), value);
+    else
+        detail::extract(j, value);
+}
+
+// @summary the same as j.get<T>(), but strings, binaries and arrays are moved out of j instead of copied if j is an
+// rvalue: json_ext::get<T>(std::move(j)). nlohmann::json::get() is const, so std::move(j).get<T>() still copies
+template <typename T, typename BasicJsonType> T get(BasicJsonType &&j)
+{
+    T value;
+    json_ext::update(value, std::forward<BasicJsonType>(j));
+    return value;
+}
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// NON-THROWING DESERIALIZATION
+namespace json_ext
+{
+// @summary either the decoded value or the decode_error why the json can't be decoded
+template <typename T> class decode_result
+{
+  public:
+    decode_result(T value) : data_(std::in_place_index<0>, std::move(value))
+    {
+    }
+
+    decode_result(decode_error error) : data_(std::in_place_index<1>, std::move(error))
+    {
+    }
+
+    bool has_value() const noexcept
+    {
+        return data_.index() == 0;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    // throws std::bad_variant_access if there is no value
+    T &value() &
+    {
+        return std::get<0>(data_);
+    }
+
+    const T &value() const &
+    {
+        return std::get<0>(data_);
+    }
+
+    T &&value() &&
+    {
+        return std::get<0>(std::move(data_));
+    }
+
+    T &operator*() &
+    {
+        return value();
+    }
+
+    const T &operator*() const &
+    {
+        return value();
+    }
+
+    T &&operator*() &&
+    {
+        return std::move(*this).value();
+    }
+
+    T *operator->()
+    {
+        return &value();
+    }
+
+    const T *operator->() const
+    {
+        return &value();
+    }
+
+    // throws std::bad_variant_access if there is a value
+    const decode_error &error() const
+    {
+        return std::get<1>(data_);
+    }
+
+  private:
+    std::variant<T, decode_error> data_;
+};
+
+// @summary the same as j.get<T>() (or json_ext::get<T>(std::move(j))), but a rejected json is returned as decode_error
+// instead of thrown. The json is checked with the probes first, they find the code and location of a failure without
+// building an exception, and only a json they accept is decoded. So a rejection costs no more than an acceptance. A
+// failure the probes don't see (e.g. of a custom from_json) is caught and returned as conversion_failed with the
+// message of the exception. Only building the decode_error itself can throw (std::bad_alloc)
+template <typename T, typename BasicJsonType> decode_result<T> try_get(BasicJsonType &&j)
+{
+    static_assert(nlohmann::detail::is_basic_json<std::decay_t<BasicJsonType>>::value);
+
+    decode_error error;
+    if (!probe<T>::can_parse(std::as_const(j), &error))
+        return {std::move(error)};
+
+    // an accepting probe may leave the failure of a rejected variant alternative behind
+    error = {};
+    error.code = decode_errc::conversion_failed;
+    try
+    {
+        return json_ext::get<T>(std::forward<BasicJsonType>(j));
+    }
+    catch (const std::exception &e)
+    {
+        error.what = e.what();
+    }
+    catch (...)
+    {
+        error.what = "unknown exception";
+    }
+    return {std::move(error)};
+}
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// KEY SIGNATURES
+namespace json_ext
+{
+namespace detail
+{
+template <typename T, std::size_t... Is> constexpr key_set<sizeof...(Is)> required_keys(std::index_sequence<Is...>)
+{
+    constexpr auto fields = T::json_ext_fields();
+
+    key_set<sizeof...(Is)> required;
+    ((std::tuple_element_t<Is, decltype(fields)>::has_default ? void() : required.insert(std::get<Is>(fields).name)),
+     ...);
+    return required;
+}
+} // namespace detail
+
+// @summary the keys a json object needs to have (required) and may have (allowed) to be deserializable into T, for
+// non-strict types every other key is allowed too
+template <typename T> struct key_signature
+{
+    static constexpr bool strict = T::json_ext_strict;
+
+    static constexpr detail::key_set<detail::key_count<T>()> allowed = [] {
+        detail::key_set<detail::key_count<T>()> allowed;
+        for (auto key : detail::key_names<T>())
+            allowed.insert(key);
+        return allowed;
+    }();
+
+    static constexpr detail::key_set<detail::field_count<T>()> required =
+        detail::required_keys<T>(std::make_index_sequence<detail::field_count<T>()>{});
+};
+
+namespace detail
+{
+template <std::size_t N> constexpr std::uint64_t key_mask(const key_table<N> &keys, std::string_view key)
+{
+    const auto index = keys.find(key);
+    return index < 64 ? std::uint64_t{1} << index : 0;
+}
+
+// @summary the union of the keys of all alternatives, every key gets one bit, so the keys of a json object can be
+// compared to the keys of each alternative with a few bit operations
+template <typename... Ts> struct variant_signature
+{
+    static constexpr std::size_t alternatives = sizeof...(Ts);
+
+    static constexpr key_table<(key_count<Ts>() + ... + 0)> keys = key_table<(key_count<Ts>() + ... + 0)>([] {
+        key_set<(key_count<Ts>() + ... + 0)> keys;
+        (
+            [&keys] {
+                for (std::size_t i = 0; i < key_signature<Ts>::allowed.size; ++i)
+                    keys.insert(key_signature<Ts>::allowed.keys[i]);
+            }(),
+            ...);
+        return keys;
+    }());
+
+    // we only have 64 bits, if the alternatives have more keys combined we fall back to probing in order
+    static constexpr bool usable = keys.size() <= 64;
+
+    template <std::size_t N> static constexpr std::uint64_t mask(const key_set<N> &signature_keys)
+    {
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < signature_keys.size; ++i)
+            mask |= key_mask(keys, signature_keys.keys[i]);
+        return mask;
+    }
+
+    // for non-strict alternatives these are only the reflected keys, every other key is allowed as well
+    static constexpr std::array<std::uint64_t, alternatives> allowed = {mask(key_signature<Ts>::allowed)...};
+    static constexpr std::array<std::uint64_t, alternatives> required = {mask(key_signature<Ts>::required)...};
+    static constexpr std::array<bool, alternatives> strict = {key_signature<Ts>::strict...};
+};
+
+// @summary signature based selection only works if we know the keys of all alternatives, the signatures don't know
+// about aliases, so alternatives which declare some are probed in order
+template <typename... Ts> constexpr bool has_variant_signature()
+{
+    if constexpr ((is_reflected<Ts>::value && ...))
+        return variant_signature<Ts...>::usable && ((alias_count<Ts>() == 0) && ...);
+    else
+        return false;
+}
+
+// @summary the alternative I is only constructed if data holds another one, otherwise it is updated in place.
+// BasicJsonType is const, unless j may be moved from
+template <std::size_t I, typename BasicJsonType, typename... Ts>
+void variant_emplace(BasicJsonType &j, std::variant<Ts...> &data)
+{
+    if (data.index() == I)
+        json_ext::detail::extract(j, std::get<I>(data));
+    else
+        data.template emplace<I>(take<std::variant_alternative_t<I, std::variant<Ts...>>>(j));
+}
+
+template <std::size_t I, typename BasicJsonType, typename... Ts>
+bool variant_emplace_if_parsable(BasicJsonType &j, std::variant<Ts...> &data)
+{
+    using T = std::variant_alternative_t<I, std::variant<Ts...>>;
+    JSON_EXT_COUNT(std::variant<Ts...>, alternatives_tried, 1);
+    if (!json_ext::can_parse<T>(j))
+        return false;
+
+    variant_emplace<I>(j, data);
+    return true;
+}
+
+// @summary decodes the alternative without probing it first, returns false if the decoding threw anything (as the
+// probes do, see probe). Only used for the last candidate, whose failure fails the whole variant, so the exception
+// costs no more than the one thrown anyway
+template <std::size_t I, typename BasicJsonType, typename... Ts>
+bool variant_emplace_or_fail(BasicJsonType &j, std::variant<Ts...> &data)
+{
+    JSON_EXT_COUNT(std::variant<Ts...>, alternatives_tried, 1);
+    try
+    {
+        variant_emplace<I>(j, data);
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+// @summary selects the alternatives by comparing the keys of j with the key signature of every alternative, only the
+// compatible alternatives are tried, the most specific first:
+//  1. the alternative which covers most keys of j
+//  2. the alternative which would need to fill the least members with default values
+//  3. the alternative which is declared first
+// The candidates are probed only to break ties, the last one (usually the only one) is decoded directly
+template <typename BasicJsonType, typename... Ts, std::size_t... Is>
+bool variant_from_json_by_signature(BasicJsonType &j, std::variant<Ts...> &data, std::index_sequence<Is...>)
+{
+    using signature = variant_signature<Ts...>;
+    static constexpr bool (*emplace_if_parsable[])(BasicJsonType &, std::variant<Ts...> &) = {
+        &variant_emplace_if_parsable<Is, BasicJsonType, Ts...>...};
+    static constexpr bool (*emplace_or_fail[])(BasicJsonType &, std::variant<Ts...> &) = {
+        &variant_emplace_or_fail<Is, BasicJsonType, Ts...>...};
+
+    if (!j.is_object())
+        return false;
+
+    std::uint64_t present = 0;
+    bool has_unknown_key = false;
+    for (auto it = j.begin(); it != j.end(); ++it)
+    {
+        const auto index = signature::keys.find(it.key());
+        if (index == npos)
+            has_unknown_key = true;
+        else
+            present |= std::uint64_t{1} << index;
+    }
+
+    std::array<std::size_t, signature::alternatives> candidates{};
+    std::array<std::size_t, signature::alternatives> matched{};
+    std::array<std::size_t, signature::alternatives> unused{};
+    std::size_t candidate_count = 0;
+    for (std::size_t i = 0; i < signature::alternatives; ++i)
+    {
+        const bool has_required = (signature::required[i] & ~present) == 0;
+        const bool has_only_allowed =
+            !signature::strict[i] || (!has_unknown_key && (present & ~signature::allowed[i]) == 0);
+        if (!has_required || !has_only_allowed)
+            continue;
+
+        matched[i] = std::bitset<64>(present & signature::allowed[i]).count();
+        unused[i] = std::bitset<64>(signature::allowed[i] & ~present).count();
+        candidates[candidate_count++] = i;
+    }
+
+    std::stable_sort(candidates.begin(), candidates.begin() + candidate_count, [&](std::size_t lhs, std::size_t rhs) {
+        return matched[lhs] != matched[rhs] ? matched[lhs] > matched[rhs] : unused[lhs] < unused[rhs];
+    });
+
+    if (candidate_count == 0)
+        return false;
+
+    for (std::size_t i = 0; i + 1 < candidate_count; ++i)
+        if (emplace_if_parsable[candidates[i]](j, data))
+            return true;
+
+    return emplace_or_fail[candidates[candidate_count - 1]](j, data);
+}
+} // namespace detail
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// TAGGED VARIANTS
+namespace json_ext
+{
+namespace detail
+{
+// @summary the tags of all alternatives in a compile time key table, the index of a tag is the index of its alternative
+template <typename... Ts> struct variant_tags
+{
+    static constexpr auto tags = make_key_table(std::array<std::string_view, sizeof...(Ts)>{Ts::json_ext_tag...});
+    static_assert(tags.size() == sizeof...(Ts), "the tags of the alternatives of a variant have to be unique");
+};
+
+
+// @summary reads the tag of j and parses exactly the alternative with this tag, returns false if j has no tag, then
+// the alternatives have to be tried as for untagged types
+template <typename BasicJsonType, typename... Ts, std::size_t... Is>
+bool variant_from_json_by_tag(BasicJsonType &j, std::variant<Ts...> &data, bool &has_parsed, std::index_sequence<Is...>)
+{
+    static constexpr void (*emplace[])(BasicJsonType &, std::variant<Ts...> &) = {
+        &variant_emplace<Is, BasicJsonType, Ts...>...};
+
+    if (!j.is_object())
+        return false;
+
+    const auto it = j.find(tag_key);
+    if (it == j.end())
+        return false;
+
+    using string_t = typename BasicJsonType::string_t;
+    const auto index =
+        it->is_string() ? variant_tags<Ts...>::tags.find(it->template get_ref<const string_t &>()) : npos;
+    if (index != npos)
+    {
+        JSON_EXT_COUNT(std::variant<Ts...>, alternatives_tried, 1);
+        emplace[index](j, data);
+        has_parsed = true;
+    }
+    return true;
+}
+} // namespace detail
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// SERIALIZATION std::variant
+template <typename T, typename BasicJsonType, typename... Ts>
+void variant_from_json(BasicJsonType &j, std::variant<Ts...> &data, bool &has_parsed)
+{
+    if (has_parsed)
+        return;
+
+    // probe first, so we don't have to pay for an exception for every alternative that doesn't match
+    JSON_EXT_COUNT(std::variant<Ts...>, alternatives_tried, 1);
+    if (!json_ext::can_parse<T>(j))
+        return;
+
+    if (std::holds_alternative<T>(data))
+        json_ext::detail::extract(j, std::get<T>(data));
+    else
+        data = json_ext::detail::take<T>(j);
+    has_parsed = true;
+}
+
+template <typename... Ts> struct nlohmann::adl_serializer<std::variant<Ts...>>
+{
+    template <typename BasicJsonType> static void to_json(BasicJsonType &j, const std::variant<Ts...> &data)
+    {
+        JSON_EXT_ENCODE_SCOPE(std::variant<Ts...>);
+        std::visit([&j](const auto &unpacked) { j = unpacked; }, data);
+    }
+
+    template <typename BasicJsonType> static void from_json(const BasicJsonType &j, std::variant<Ts...> &data)
+    {
+        from_json_impl(j, data);
+    }
+
+    // moves the strings and arrays of j into the selected alternative
+    template <typename BasicJsonType,
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>
+    static void from_json(BasicJsonType &&j, std::variant<Ts...> &data)
+    {
+        from_json_impl(j, data);
+    }
+
+  private:
+    template <typename BasicJsonType> static void from_json_impl(BasicJsonType &j, std::variant<Ts...> &data)
+    {
+        JSON_EXT_DECODE_SCOPE(std::variant<Ts...>);
+        bool has_parsed = false;
+        bool has_tag = false;
+        // if all alternatives are tagged the tag decides which alternative is parsed
+        if constexpr ((json_ext::detail::is_tagged<Ts>::value && ...))
+            has_tag = json_ext::detail::variant_from_json_by_tag(j, data, has_parsed, std::index_sequence_for<Ts...>{});
+
+        if (!has_tag)
+        {
+            // if all alternatives are reflected we know their keys and can select the alternative directly
+            if constexpr (json_ext::detail::has_variant_signature<Ts...>())
+                has_parsed =
+                    json_ext::detail::variant_from_json_by_signature(j, data, std::index_sequence_for<Ts...>{});
+            else
+                (variant_from_json<Ts>(j, data, has_parsed), ...);
+        }
+
+        // the same message as decode_errc::no_matching_variant, the json itself may be the whole document
+        if (!has_parsed)
+            throw nlohmann::detail::other_error::create(
+                601, nlohmann::detail::concat("unable to find matching variant for ", j.type_name()), &j);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// SERIALIZATION std::optional
+template <typename T> struct nlohmann::adl_serializer<std::optional<T>>
+{
+    template <typename BasicJsonType> static void to_json(BasicJsonType &j, const std::optional<T> &data)
+    {
+        if (data)
+            j = *data;
+    }
+
+    template <typename BasicJsonType> static void from_json(const BasicJsonType &j, std::optional<T> &data)
+    {
+        from_json_impl(j, data);
+    }
+
+    // moves the strings and arrays of j into the value
+    template <typename BasicJsonType,
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>
+    static void from_json(BasicJsonType &&j, std::optional<T> &data)
+    {
+        from_json_impl(j, data);
+    }
+
+  private:
+    template <typename BasicJsonType> static void from_json_impl(BasicJsonType &j, std::optional<T> &data)
+    {
+        if (j.is_null())
+            data.reset();
+        // an existing value is updated in place
+        else if (data.has_value())
+            json_ext::detail::extract(j, *data);
+        else
+            data = json_ext::detail::take<T>(j);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// ARENA ALLOCATION
+namespace json_ext
+{
+namespace detail
+{
+inline std::pmr::memory_resource *&current_arena() noexcept
+{
+    thread_local std::pmr::memory_resource *arena = nullptr;
+    return arena;
+}
+} // namespace detail
+
+// @summary routes every allocation of arena_allocator on this thread to arena while the scope lives, scopes can be
+// nested, the previous arena is restored on destruction
+class arena_scope
+{
+  public:
+    explicit arena_scope(std::pmr::memory_resource &arena) noexcept : previous_(detail::current_arena())
+    {
+        detail::current_arena() = &arena;
+    }
+
+    arena_scope(const arena_scope &) = delete;
+    arena_scope &operator=(const arena_scope &) = delete;
+
+    ~arena_scope()
+    {
+        detail::current_arena() = previous_;
+    }
+
+  private:
+    std::pmr::memory_resource *previous_;
+};
+
+// @summary allocator for nlohmann::basic_json, which default constructs its allocators for every allocation, so the
+// resource can't be passed as state. Allocates from the arena of the current arena_scope (or the default resource
+// without scope) and stores the resource in front of every allocation, so it is always returned to the resource it
+// came from
+template <typename T> struct arena_allocator
+{
+    using value_type = T;
+
+    arena_allocator() noexcept = default;
+
+    template <typename U> arena_allocator(const arena_allocator<U> &) noexcept
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        // T may be incomplete when the allocator type is instantiated (e.g. the value type of a basic_json object)
+        static_assert(alignof(T) <= alignment, "over-aligned types are not supported");
+
+        auto *resource = detail::current_arena() ? detail::current_arena() : std::pmr::get_default_resource();
+        void *raw = resource->allocate(header + n * sizeof(T), alignment);
+        *static_cast<std::pmr::memory_resource **>(raw) = resource;
+        return reinterpret_cast<T *>(static_cast<char *>(raw) + header);
+    }
+
+    void deallocate(T *ptr, std::size_t n) noexcept
+    {
+        void *raw = reinterpret_cast<char *>(ptr) - header;
+        (*static_cast<std::pmr::memory_resource **>(raw))->deallocate(raw, header + n * sizeof(T), alignment);
+    }
+
+    template <typename U> bool operator==(const arena_allocator<U> &) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U> bool operator!=(const arena_allocator<U> &) const noexcept
+    {
+        return false;
+    }
+
+  private:
+    static constexpr std::size_t alignment = alignof(std::max_align_t);
+    static constexpr std::size_t header = alignment;
+};
+
+// @summary the string_t of arena_json, so the characters of strings and keys longer than the small string buffer come
+// from the arena as well
+using arena_string = std::basic_string<char, std::char_traits<char>, arena_allocator<char>>;
+
+// @summary a basic_json which allocates its objects, arrays, strings and keys from the arena of the current
+// arena_scope, works with every type defined with NLOHMANN_SERIALIZE. Only the destructor of basic_json allocates a
+// temporary stack with std::allocator to flatten nested arrays and objects
+using arena_json = nlohmann::basic_json<std::map, std::vector, arena_string, bool, std::int64_t, std::uint64_t, double,
+                                        arena_allocator>;
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// SAX DESERIALIZATION
+namespace json_ext
+{
+namespace detail
+{
+// @summary one SAX event, values are passed to the frame which currently receives values
+struct sax_event
+{
+    enum class kind
+    {
+        null,
+        boolean,
+        number_integer,
+        number_unsigned,
+        number_float,
+        string,
+        binary,
+        start_object,
+        start_array,
+    };
+
+    kind type;
+    bool boolean = false;
+    nlohmann::json::number_integer_t number_integer = 0;
+    nlohmann::json::number_unsigned_t number_unsigned = 0;
+    nlohmann::json::number_float_t number_float = 0;
+    nlohmann::json::string_t *string = nullptr;
+    nlohmann::json::binary_t *binary = nullptr;
+    std::size_t elements = static_cast<std::size_t>(-1);
+
+    // @summary the same type names nlohmann::json::type_name() would return for the parsed value
+    const char *type_name() const
+    {
+        switch (type)
+        {
+        case kind::null:
+            return "null";
+        case kind::boolean:
+            return "boolean";
+        case kind::string:
+            return "string";
+        case kind::binary:
+            return "binary";
+        case kind::start_object:
+            return "object";
+        case kind::start_array:
+            return "array";
+        default:
+            return "number";
+        }
+    }
+
+    bool is_number() const
+    {
+        return type == kind::number_integer || type == kind::number_unsigned || type == kind::number_float;
+    }
+
+    bool is_scalar() const
+    {
+        return type != kind::start_object && type != kind::start_array;
+    }
+
+    nlohmann::json to_json() const
+    {
+        switch (type)
+        {
+        case kind::boolean:
+            return boolean;
+        case kind::number_integer:
+            return number_integer;
+        case kind::number_unsigned:
+            return number_unsigned;
+        case kind::number_float:
+            return number_float;
+        case kind::string:
+            return *string;
+        case kind::binary:
+            return nlohmann::json::binary_t(*binary);
+        default:
+            return nullptr;
+        }
+    }
+
+    [[noreturn]] void throw_type_error(const char *expected) const
+    {
+        throw nlohmann::detail::type_error::create(
+            302, nlohmann::detail::concat("type must be ", expected, ", but is ", type_name()), nullptr);
+    }
+};
+
+// @summary one level of the value we are currently parsing into, e.g. an object or an array
+class sax_frame
+{
+  public:
+    virtual ~sax_frame() = default;
+
+    // returns the frame for the new object / array if the value starts one
+    virtual std::unique_ptr<sax_frame> value(sax_event &event) = 0;
+
+    virtual void key(nlohmann::json::string_t &)
+    {
+    }
+
+    // returns true if the frame is finished and has to be removed
+    virtual bool end(bool is_object) = 0;
+};
+
+// @summary describes how a T is parsed from SAX events, the default parses the value into a json and converts it
+// with the usual from_json, so every type which works with j.get<T>() works here too (e.g. std::variant)
+template <typename T, typename = void> struct sax_value;
+
+template <typename T> std::unique_ptr<sax_frame> sax_parse_value(T &target, sax_event &event)
+{
+    return sax_value<T>::parse(target, event);
+}
+
+// @summary collects a subtree into a json, with the same parser nlohmann::json::parse uses
+template <typename T> class sax_dom_frame : public sax_frame
+{
+  public:
+    sax_dom_frame(T &target, sax_event &event) : target_(target), parser_(json_)
+    {
+        value(event);
+    }
+
+    std::unique_ptr<sax_frame> value(sax_event &event) override
+    {
+        switch (event.type)
+        {
+        case sax_event::kind::null:
+            parser_.null();
+            break;
+        case sax_event::kind::boolean:
+            parser_.boolean(event.boolean);
+            break;
+        case sax_event::kind::number_integer:
+            parser_.number_integer(event.number_integer);
+            break;
+        case sax_event::kind::number_unsigned:
+            parser_.number_unsigned(event.number_unsigned);
+            break;
+        case sax_event::kind::number_float:
+            parser_.number_float(event.number_float, {});
+            break;
+        case sax_event::kind::string:
+            parser_.string(*event.string);
+            break;
+        case sax_event::kind::binary:
+            parser_.binary(*event.binary);
+            break;
+        case sax_event::kind::start_object:
+            ++depth_;
+            parser_.start_object(event.elements);
+            break;
+        case sax_event::kind::start_array:
+            ++depth_;
+            parser_.start_array(event.elements);
+            break;
+        }
+        return nullptr;
+    }
+
+    void key(nlohmann::json::string_t &key) override
+    {
+        parser_.key(key);
+    }
+
+    bool end(bool is_object) override
+    {
+        if (is_object)
+            parser_.end_object();
+        else
+            parser_.end_array();
+
+        if (--depth_ != 0)
+            return false;
+
+        json_.get_to(target_);
+        return true;
+    }
+
+  private:
+    T &target_;
+    nlohmann::json json_;
+    nlohmann::detail::json_sax_dom_parser<nlohmann::json> parser_;
+    std::size_t depth_ = 0;
+};
+
+// @summary skips a subtree, e.g. the value of a key which isn't reflected
+class sax_skip_frame : public sax_frame
+{
+  public:
+    std::unique_ptr<sax_frame> value(sax_event &event) override
+    {
+        if (!event.is_scalar())
+            ++depth_;
+        return nullptr;
+    }
+
+    bool end(bool) override
+    {
+        return --depth_ == 0;
+    }
+
+  private:
+    std::size_t depth_ = 1;
+};
+
+template <typename T, typename> struct sax_value
+{
+    static std::unique_ptr<sax_frame> parse(T &target, sax_event &event)
+    {
+        if (!event.is_scalar())
+            return std::make_unique<sax_dom_frame<T>>(target, event);
+
+        event.to_json().get_to(target);
+        return nullptr;
+    }
+};
+
+template <> struct sax_value<nlohmann::json::boolean_t>
+{
+    static std::unique_ptr<sax_frame> parse(bool &target, sax_event &event)
+    {
+        if (event.type != sax_event::kind::boolean)
+            event.throw_type_error("boolean");
+
+        target = event.boolean;
+        return nullptr;
+    }
+};
+
+template <typename T>
+struct sax_value<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, nlohmann::json::boolean_t>>>
+{
+    static std::unique_ptr<sax_frame> parse(T &target, sax_event &event)
+    {
+        switch (event.type)
+        {
+        case sax_event::kind::number_integer:
+            target = static_cast<T>(event.number_integer);
+            break;
+        case sax_event::kind::number_unsigned:
+            target = static_cast<T>(event.number_unsigned);
+            break;
+        case sax_event::kind::number_float:
+            target = static_cast<T>(event.number_float);
+            break;
+        case sax_event::kind::boolean:
+            // the same as in the probe, nlohmann converts booleans to all arithmetic types except its own
+            if (std::is_same_v<T, nlohmann::json::number_integer_t> ||
+                std::is_same_v<T, nlohmann::json::number_unsigned_t> ||
+                std::is_same_v<T, nlohmann::json::number_float_t>)
+                event.throw_type_error("number");
+            target = static_cast<T>(event.boolean);
+            break;
+        default:
+            event.throw_type_error("number");
+        }
+        return nullptr;
+    }
+};
+
+template <> struct sax_value<nlohmann::json::string_t>
+{
+    static std::unique_ptr<sax_frame> parse(nlohmann::json::string_t &target, sax_event &event)
+    {
+        if (event.type != sax_event::kind::string)
+            event.throw_type_error("string");
+
+        target = *event.string;
+        return nullptr;
+    }
+};
+
+template <typename T> struct sax_value<T, std::enable_if_t<is_reflected_enum<T>::value>>
+{
+    static std::unique_ptr<sax_frame> parse(T &target, sax_event &event)
+    {
+        std::size_t index = npos;
+        if constexpr (enum_table<T>::reflection.as_integer)
+        {
+            if (!event.is_number())
+                event.throw_type_error("number");
+            if (event.type == sax_event::kind::number_integer && event.number_integer >= 0)
+                index = static_cast<std::size_t>(event.number_integer);
+            else if (event.type == sax_event::kind::number_unsigned)
+                index = static_cast<std::size_t>(event.number_unsigned);
+            if (index >= enum_table<T>::reflection.names.size())
+                index = npos;
+        }
+        else
+        {
+            if (event.type != sax_event::kind::string)
+                event.throw_type_error("string");
+            index = enum_table<T>::names.find(*event.string);
+        }
+
+        if (index == npos)
+            throw_unknown_enumerator<T>(event.to_json().dump());
+        target = static_cast<T>(index);
+        return nullptr;
+    }
+};
+
+template <typename T> struct sax_value<std::optional<T>>
+{
+    static std::unique_ptr<sax_frame> parse(std::optional<T> &target, sax_event &event)
+    {
+        if (event.type == sax_event::kind::null)
+        {
+            target.reset();
+            return nullptr;
+        }
+
+        if (!target)
+            target.emplace();
+        return sax_parse_value(*target, event);
+    }
+};
+
+template <typename T, typename Allocator> class sax_array_frame : public sax_frame
+{
+  public:
+    explicit sax_array_frame(std::vector<T, Allocator> &target) : target_(target)
+    {
+        target_.clear();
+    }
+
+    std::unique_ptr<sax_frame> value(sax_event &event) override
+    {
+        return sax_parse_value(target_.emplace_back(), event);
+    }
+
+    bool end(bool) override
+    {
+        return true;
+    }
+
+  private:
+    std::vector<T, Allocator> &target_;
+};
+
+template <typename T, typename Allocator>
+struct sax_value<std::vector<T, Allocator>, std::enable_if_t<!std::is_same_v<T, bool>>>
+{
+    static std::unique_ptr<sax_frame> parse(std::vector<T, Allocator> &target, sax_event &event)
+    {
+        if (event.type != sax_event::kind::start_array)
+            event.throw_type_error("array");
+
+        return std::make_unique<sax_array_frame<T, Allocator>>(target);
+    }
+};
+
+// @summary the error the generated from_json throws for a json which isn't an object, it fails on the first member,
+// either with at() or with value()
+template <typename T> [[noreturn]] void throw_not_an_object(const char *type_name)
+{
+    if constexpr (field_count<T>() == 0 || !std::tuple_element_t<0, decltype(T::json_ext_fields())>::has_default)
+        throw nlohmann::detail::type_error::create(
+            304, nlohmann::detail::concat("cannot use at() with ", type_name), nullptr);
+    else
+        throw nlohmann::detail::type_error::create(
+            306, nlohmann::detail::concat("cannot use value() with ", type_name), nullptr);
+}
+
+// @summary parses the members of a reflected type, keys are looked up in the compile time key table of the type
+template <typename T> class sax_object_frame : public sax_frame
+{
+  public:
+    explicit sax_object_frame(T &target) : target_(target)
+    {
+    }
+
+    void key(nlohmann::json::string_t &key) override
+    {
+        bool is_alias;
+        current_ = field_index<T>(key, is_alias);
+        if (current_ == npos && T::json_ext_strict)
+        {
+            JSON_EXT_COUNT(T, strict_rejections, 1);
+            throw nlohmann::detail::other_error::create(
+                600, nlohmann::detail::concat("key '", key, "' not present in reflected keys"), nullptr);
+        }
+        // an alias after the name of its field is skipped
+        if (!precedence_.accept(current_, is_alias))
+            current_ = npos;
+    }
+
+    std::unique_ptr<sax_frame> value(sax_event &event) override
+    {
+        if (current_ == npos)
+            return event.is_scalar() ? nullptr : std::make_unique<sax_skip_frame>();
+
+        if constexpr (is_tagged<T>::value)
+        {
+            if (current_ == field_count<T>())
+            {
+                if (event.type != sax_event::kind::string || *event.string != T::json_ext_tag)
+                    throw_tag_mismatch(T::json_ext_tag, event.is_scalar() ? event.to_json().dump() : event.type_name());
+                return nullptr;
+            }
+        }
+
+        seen_.set(current_);
+        return parse_field(event, std::make_index_sequence<field_count<T>()>{});
+    }
+
+    bool end(bool) override
+    {
+        // the same as the generated from_json, missing members are either defaulted or the key is required
+        std::apply([this](const auto &...fields) { std::size_t i = 0; (finish_field(fields, i++), ...); },
+                   T::json_ext_fields());
+        return true;
+    }
+
+  private:
+    template <std::size_t... Is>
+    std::unique_ptr<sax_frame> parse_field(sax_event &event, std::index_sequence<Is...>)
+    {
+        static constexpr auto fields = T::json_ext_fields();
+
+        std::unique_ptr<sax_frame> frame;
+        ((current_ == Is && (frame = sax_parse_value(target_.*(std::get<Is>(fields).member), event), true)) || ...);
+        return frame;
+    }
+
+    template <typename Field> void finish_field(const Field &field, std::size_t index)
+    {
+        if (seen_.test(index))
+            return;
+
+        if constexpr (Field::has_default)
+            field.set_default(target_);
+        else
+            throw nlohmann::detail::out_of_range::create(
+                403, nlohmann::detail::concat("key '", std::string(field.name), "' not found"), nullptr);
+    }
+
+    T &target_;
+    std::size_t current_ = npos;
+    std::bitset<field_count<T>()> seen_;
+    key_precedence<T> precedence_;
+};
+
+template <typename T> struct sax_value<T, std::enable_if_t<is_reflected<T>::value>>
+{
+    static std::unique_ptr<sax_frame> parse(T &target, sax_event &event)
+    {
+        if (event.type != sax_event::kind::start_object)
+            throw_not_an_object<T>(event.type_name());
+
+        return std::make_unique<sax_object_frame<T>>(target);
+    }
+};
+
+// @summary root frame, receives the top level value
+template <typename T> class sax_root_frame : public sax_frame
+{
+  public:
+    explicit sax_root_frame(T &target) : target_(target)
+    {
+    }
+
+    std::unique_ptr<sax_frame> value(sax_event &event) override
+    {
+        return sax_parse_value(target_, event);
+    }
+
+    bool end(bool) override
+    {
+        return false;
+    }
+
+  private:
+    T &target_;
+};
+
+// @summary SAX handler for nlohmann::json::sax_parse, which writes the parsed values directly into a T
+template <typename T> class sax_decoder
+{
+  public:
+    using number_integer_t = nlohmann::json::number_integer_t;
+    using number_unsigned_t = nlohmann::json::number_unsigned_t;
+    using number_float_t = nlohmann::json::number_float_t;
+    using string_t = nlohmann::json::string_t;
+    using binary_t = nlohmann::json::binary_t;
+
+    explicit sax_decoder(T &target)
+    {
+        frames_.push_back(std::make_unique<sax_root_frame<T>>(target));
+    }
+
+    bool null()
+    {
+        return dispatch({sax_event::kind::null});
+    }
+
+    bool boolean(bool val)
+    {
+        sax_event event{sax_event::kind::boolean};
+        event.boolean = val;
+        return dispatch(event);
+    }
+
+    bool number_integer(number_integer_t val)
+    {
+        sax_event event{sax_event::kind::number_integer};
+        event.number_integer = val;
+        return dispatch(event);
+    }
+
+    bool number_unsigned(number_unsigned_t val)
+    {
+        sax_event event{sax_event::kind::number_unsigned};
+        event.number_unsigned = val;
+        return dispatch(event);
+    }
+
+    bool number_float(number_float_t val, const string_t &)
+    {
+        sax_event event{sax_event::kind::number_float};
+        event.number_float = val;
+        return dispatch(event);
+    }
+
+    bool string(string_t &val)
+    {
+        sax_event event{sax_event::kind::string};
+        event.string = &val;
+        return dispatch(event);
+    }
+
+    bool binary(binary_t &val)
+    {
+        sax_event event{sax_event::kind::binary};
+        event.binary = &val;
+        return dispatch(event);
+    }
+
+    bool start_object(std::size_t elements)
+    {
+        sax_event event{sax_event::kind::start_object};
+        event.elements = elements;
+        return dispatch(event);
+    }
+
+    bool key(string_t &val)
+    {
+        frames_.back()->key(val);
+        return true;
+    }
+
+    bool end_object()
+    {
+        return end(true);
+    }
+
+    bool start_array(std::size_t elements)
+    {
+        sax_event event{sax_event::kind::start_array};
+        event.elements = elements;
+        return dispatch(event);
+    }
+
+    bool end_array()
+    {
+        return end(false);
+    }
+
+    template <typename Exception> bool parse_error(std::size_t, const std::string &, const Exception &ex)
+    {
+        throw ex;
+    }
+
+  private:
+    bool dispatch(sax_event event)
+    {
+        if (auto frame = frames_.back()->value(event))
+            frames_.push_back(std::move(frame));
+        return true;
+    }
+
+    bool end(bool is_object)
+    {
+        if (frames_.back()->end(is_object))
+            frames_.pop_back();
+        return true;
+    }
+
+    std::vector<std::unique_ptr<sax_frame>> frames_;
+};
+} // namespace detail
+
+// @summary parses json directly into a T without building a nlohmann::json first, for reflected types, optionals,
+// vectors and the basic types. Every other type (e.g. std::variant) is parsed into a json for its subtree and converted
+// with from_json. Accepts and rejects exactly the same json as j.get<T>(), and a json with a single error throws the
+// same exception. With several errors the first one found is thrown, which may differ: j.get<T>() checks all keys of a
+// strict type before it decodes a member, parse_into rejects an unknown key when it reaches it. A non-empty array for
+// a strict type throws type_error 304 (at() with array) instead of other_error 600 (its index as unknown key).
+template <typename T> void parse_into(std::string_view input, T &value)
+{
+    JSON_EXT_DECODE_SCOPE(T);
+    JSON_EXT_COUNT(T, decoded_bytes, input.size());
+    detail::sax_decoder<T> decoder(value);
+    nlohmann::json::sax_parse(input.begin(), input.end(), &decoder);
+}
+
+template <typename T> T parse_into(std::string_view input)
+{
+    T value;
+    parse_into(input, value);
+    return value;
+}
+
+template <typename T> void parse_into(std::istream &input, T &value)
+{
+    JSON_EXT_DECODE_SCOPE(T);
+    detail::sax_decoder<T> decoder(value);
+    nlohmann::json::sax_parse(input, &decoder);
+}
+
+template <typename T> T parse_into(std::istream &input)
+{
+    T value;
+    parse_into(input, value);
+    return value;
+}
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// LAZY VIEWS
+namespace json_ext
+{
+namespace detail
+{
+// @summary position is the index of the unexpected character, nlohmann::json counts the bytes from 1
+[[noreturn]] inline void throw_scan_error(std::size_t position, const std::string &message)
+{
+    throw nlohmann::detail::parse_error::create(
+        101, position + 1, nlohmann::detail::concat("syntax error while scanning object: ", message), nullptr);
+}
+
+constexpr bool is_whitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline std::size_t skip_whitespace(std::string_view input, std::size_t pos)
+{
+    while (pos < input.size() && is_whitespace(input[pos]))
+        ++pos;
+    return pos;
+}
+
+// @summary the position after the string starting at pos (at its opening quote)
+inline std::size_t skip_string(std::string_view input, std::size_t pos)
+{
+    for (++pos; pos < input.size(); ++pos)
+    {
+        if (input[pos] == '\\')
+            ++pos;
+        else if (input[pos] == '"')
+            return pos + 1;
+    }
+    throw_scan_error(input.size(), "unexpected end of input, expected '\"'");
+}
+
+// @summary the position after the value starting at pos, only strings and nesting are tracked, everything else is
+// validated when the value is decoded
+inline std::size_t skip_value(std::string_view input, std::size_t pos)
+{
+    if (pos == input.size())
+        throw_scan_error(pos, "unexpected end of input, expected a value");
+
+    const char first = input[pos];
+    if (first == '"')
+        return skip_string(input, pos);
+
+    if (first != '{' && first != '[')
+    {
+        while (pos < input.size() && !is_whitespace(input[pos]) && input[pos] != ',' && input[pos] != '}' &&
+               input[pos] != ']')
+            ++pos;
+        return pos;
+    }
+
+    std::size_t depth = 0;
+    while (pos < input.size())
+    {
+        switch (input[pos])
+        {
+        case '"':
+            pos = skip_string(input, pos);
+            continue;
+        case '{':
+        case '[':
+            ++depth;
+            break;
+        case '}':
+        case ']':
+            if (--depth == 0)
+                return pos + 1;
+            break;
+        default:
+            break;
+        }
+        ++pos;
+    }
+    throw_scan_error(input.size(), "unexpected end of input, expected '}' or ']'");
+}
+
+// @summary the type name nlohmann::json would report for the value starting with c
+constexpr const char *scanned_type_name(char c)
+{
+    switch (c)
+    {
+    case '{':
+        return "object";
+    case '[':
+        return "array";
+    case '"':
+        return "string";
+    case 't':
+    case 'f':
+        return "boolean";
+    case 'n':
+        return "null";
+    default:
+        return "number";
+    }
+}
+
+// @summary calls on_member(quoted_key, position) for every member of the object at pos (at its '{'), on_member returns
+// the position after the value. Returns the position after the object
+template <typename OnMember> std::size_t scan_object(std::string_view input, std::size_t pos, OnMember &&on_member)
+{
+    pos = skip_whitespace(input, pos + 1);
+    if (pos < input.size() && input[pos] == '}')
+        return pos + 1;
+
+    for (;;)
+    {
+        if (pos == input.size() || input[pos] != '"')
+            throw_scan_error(pos, "expected a key");
+        const auto key_end = skip_string(input, pos);
+        const auto quoted_key = input.substr(pos, key_end - pos);
+
+        pos = skip_whitespace(input, key_end);
+        if (pos == input.size() || input[pos] != ':')
+            throw_scan_error(pos, "expected ':'");
+
+        pos = skip_whitespace(input, pos + 1);
+        if (pos == input.size())
+            throw_scan_error(pos, "unexpected end of input, expected a value");
+        pos = skip_whitespace(input, on_member(quoted_key, pos));
+
+        if (pos < input.size() && input[pos] == ',')
+            pos = skip_whitespace(input, pos + 1);
+        else if (pos < input.size() && input[pos] == '}')
+            return pos + 1;
+        else
+            throw_scan_error(pos, "expected ',' or '}'");
+    }
+}
+
+// @summary the same as scan_object for the elements of the array at pos (at its '['), on_element(position) returns
+// the position after the element
+template <typename OnElement> std::size_t scan_array(std::string_view input, std::size_t pos, OnElement &&on_element)
+{
+    pos = skip_whitespace(input, pos + 1);
+    if (pos < input.size() && input[pos] == ']')
+        return pos + 1;
+
+    for (;;)
+    {
+        if (pos == input.size())
+            throw_scan_error(pos, "unexpected end of input, expected a value");
+        pos = skip_whitespace(input, on_element(pos));
+
+        if (pos < input.size() && input[pos] == ',')
+            pos = skip_whitespace(input, pos + 1);
+        else if (pos < input.size() && input[pos] == ']')
+            return pos + 1;
+        else
+            throw_scan_error(pos, "expected ',' or ']'");
+    }
+}
+
+// @summary the index of a scanned key in key_names<T>(), quoted_key still has its quotes, only escaped keys are
+// decoded. Throws for unknown keys of strict types
+template <typename T> std::size_t scanned_key_index(std::string_view quoted_key, bool &is_alias)
+{
+    const auto key = quoted_key.substr(1, quoted_key.size() - 2);
+    const auto index = key.find('\\') == std::string_view::npos
+                           ? field_index<T>(key, is_alias)
+                           : field_index<T>(parse_into<std::string>(quoted_key), is_alias);
+
+    if constexpr (T::json_ext_strict)
+    {
+        if (index == npos)
+        {
+            JSON_EXT_COUNT(T, strict_rejections, 1);
+            throw nlohmann::detail::other_error::create(
+                600, nlohmann::detail::concat("key '", std::string(key), "' not present in reflected keys"), nullptr);
+        }
+    }
+    return index;
+}
+
+// @summary checks the raw value of the tag of T
+template <typename T> void check_scanned_tag(std::string_view value)
+{
+    if constexpr (is_tagged<T>::value)
+    {
+        // only a tag which isn't the plain quoted tag has to be parsed
+        const bool is_quoted_tag = value.size() == T::json_ext_tag.size() + 2 && value.front() == '"' &&
+                                   value.substr(1, T::json_ext_tag.size()) == T::json_ext_tag;
+        if (!is_quoted_tag)
+        {
+            const auto tag = parse_into<nlohmann::json>(value);
+            if (!has_matching_tag<T>(tag))
+                throw_tag_mismatch(T::json_ext_tag, tag.dump());
+        }
+    }
+}
+
+// @summary checks that only whitespace follows the value which ends at pos
+inline void expect_end(std::string_view input, std::size_t pos)
+{
+    pos = skip_whitespace(input, pos);
+    if (pos != input.size())
+        throw_scan_error(pos, "unexpected content after the value");
+}
+
+template <auto Member, typename M> constexpr bool is_same_member(M member)
+{
+    if constexpr (std::is_same_v<M, decltype(Member)>)
+        return member == Member;
+    else
+        return false;
+}
+
+template <typename T, auto Member, std::size_t... Is> constexpr std::size_t member_index(std::index_sequence<Is...>)
+{
+    constexpr auto fields = T::json_ext_fields();
+
+    std::size_t index = npos;
+    ((is_same_member<Member>(std::get<Is>(fields).member) && (index = Is, true)) || ...);
+    return index;
+}
+
+// @summary the index of the reflected member Member of T in json_ext_fields(), npos if it isn't reflected
+template <typename T, auto Member> constexpr std::size_t member_index()
+{
+    return member_index<T, Member>(std::make_index_sequence<field_count<T>()>{});
+}
+} // namespace detail
+
+// @summary a view of a json object in input, which decodes the members of T only when they are accessed. The
+// constructor scans the object once and remembers where the values of the reflected keys are, get<&T::member>() decodes
+// the value with parse_into on the first access and caches it. Defaults and required members behave as with the
+// generated from_json, the tag and unknown keys of strict types are checked by the scan. The values of members which
+// are never accessed are not validated. input has to outlive the view, the cache isn't thread safe
+template <typename T> class lazy_view
+{
+    static_assert(detail::is_reflected<T>::value, "lazy_view needs a type defined with NLOHMANN_SERIALIZE");
+
+  public:
+    explicit lazy_view(std::string_view input) : input_(input)
+    {
+        scan();
+    }
+
+    // @summary the whole object, e.g. to forward it untouched
+    std::string_view raw() const noexcept
+    {
+        return input_;
+    }
+
+    // @summary the raw json of the member, empty if the key is missing
+    template <auto Member> std::string_view raw() const noexcept
+    {
+        return values_[index<Member>()];
+    }
+
+    template <auto Member> bool contains() const noexcept
+    {
+        return values_[index<Member>()].data() != nullptr;
+    }
+
+    // @summary the decoded member, the default value if the key is missing, throws if a required key is missing or
+    // the value can't be decoded. A missing member with default decodes the members declared before it first
+    template <auto Member> const auto &get() const
+    {
+        constexpr auto I = index<Member>();
+        if (!decoded_.test(I))
+        {
+            decode<I>();
+            decoded_.set(I);
+        }
+        return value_.*Member;
+    }
+
+    // @summary decodes all members which aren't decoded yet
+    T to_value() const
+    {
+        decode_all(std::make_index_sequence<detail::field_count<T>()>{});
+        return value_;
+    }
+
+  private:
+    template <auto Member> static constexpr std::size_t index()
+    {
+        constexpr auto I = detail::member_index<T, Member>();
+        static_assert(I != detail::npos, "the member isn't reflected by NLOHMANN_SERIALIZE");
+        return I;
+    }
+
+    void scan()
+    {
+        auto pos = detail::skip_whitespace(input_, 0);
+        if (pos == input_.size())
+            detail::throw_scan_error(pos, "unexpected end of input, expected '{'");
+        if (input_[pos] != '{')
+            detail::throw_not_an_object<T>(detail::scanned_type_name(input_[pos]));
+
+        detail::key_precedence<T> precedence;
+        pos = detail::scan_object(input_, pos, [&](std::string_view quoted_key, std::size_t value_begin) {
+            const auto value_end = detail::skip_value(input_, value_begin);
+            const auto value = input_.substr(value_begin, value_end - value_begin);
+
+            bool is_alias;
+            const auto index = detail::scanned_key_index<T>(quoted_key, is_alias);
+            if (index < detail::field_count<T>())
+            {
+                if (precedence.accept(index, is_alias))
+                    values_[index] = value;
+            }
+            else if (index != detail::npos)
+                detail::check_scanned_tag<T>(value);
+            return value_end;
+        });
+        detail::expect_end(input_, pos);
+    }
+
+    template <std::size_t I> void decode() const
+    {
+        static constexpr auto fields = T::json_ext_fields();
+        const auto &field = std::get<I>(fields);
+
+        if (values_[I].data() != nullptr)
+            parse_into(values_[I], value_.*(field.member));
+        else if constexpr (std::tuple_element_t<I, decltype(fields)>::has_default)
+        {
+            // the default may refer to the members declared before it, they are decoded first as by get
+            decode_all(std::make_index_sequence<I>{});
+            field.set_default(value_);
+        }
+        else
+            throw nlohmann::detail::out_of_range::create(
+                403, nlohmann::detail::concat("key '", std::string(field.name), "' not found"), nullptr);
+    }
+
+    template <std::size_t... Is> void decode_all(std::index_sequence<Is...>) const
+    {
+        ((decoded_.test(Is) ? void() : (decode<Is>(), decoded_.set(Is), void())), ...);
+    }
+
+    std::string_view input_;
+    // data() is null for missing keys
+    std::array<std::string_view, detail::field_count<T>()> values_{};
+    mutable T value_{};
+    mutable std::bitset<detail::field_count<T>()> decoded_;
+};
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// DIRECT SERIALIZATION
+namespace json_ext
+{
+namespace detail
+{
+// @summary the indices of names in the order of the sorted names
+template <std::size_t N> constexpr std::array<std::size_t, N> sorted_order(const std::array<std::string_view, N> &names)
+{
+    std::array<std::size_t, N> order{};
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        std::size_t j = i;
+        for (; j > 0 && names[i] < names[order[j - 1]]; --j)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+    return order;
+}
+
+// @summary the keys of T (see key_names) sorted, nlohmann::json stores objects in a std::map, so this is the order
+// dump() writes them in
+template <typename T> constexpr std::array<std::size_t, key_count<T>()> sorted_key_order()
+{
+    return sorted_order(key_names<T>());
+}
+
+struct string_sink
+{
+    std::string &out;
+
+    void put(char c)
+    {
+        out.push_back(c);
+    }
+
+    void put(std::string_view s)
+    {
+        out.append(s.data(), s.size());
+    }
+};
+
+template <typename OutputIt> struct iterator_sink
+{
+    OutputIt out;
+
+    void put(char c)
+    {
+        *out++ = c;
+    }
+
+    void put(std::string_view s)
+    {
+        out = std::copy(s.begin(), s.end(), out);
+    }
+};
+
+constexpr std::uint8_t utf8_accept = 0;
+constexpr std::uint8_t utf8_reject = 1;
+
+// @summary the utf-8 decoder nlohmann::json uses to validate strings in dump()
+// (http://bjoern.hoehrmann.de/utf-8/decoder/dfa/), we only need the state, not the code point
+inline std::uint8_t utf8_decode(std::uint8_t state, std::uint8_t byte) noexcept
+{
+    static constexpr std::array<std::uint8_t, 400> utf8d = {{
+        // clang-format off
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 00..1F
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 20..3F
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 40..5F
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 60..7F
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, // 80..9F
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, // A0..BF
+        8, 8, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, // C0..DF
+        0xA, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x4, 0x3, 0x3, // E0..EF
+        0xB, 0x6, 0x6, 0x6, 0x5, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, // F0..FF
+        0x0, 0x1, 0x2, 0x3, 0x5, 0x8, 0x7, 0x1, 0x1, 0x1, 0x4, 0x6, 0x1, 0x1, 0x1, 0x1, // s0..s0
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, // s1..s2
+        1, 2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, // s3..s4
+        1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 1, 3, 1, 1, 1, 1, 1, 1, // s5..s6
+        1, 3, 1, 1, 1, 1, 1, 3, 1, 3, 1, 1, 1, 1, 1, 1, 1, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 // s7..s8
+        // clang-format on
+    }};
+
+    return utf8d[256u + state * 16u + utf8d[byte]];
+}
+
+inline std::string hex_byte(std::uint8_t byte)
+{
+    constexpr const char *nibble_to_hex = "0123456789ABCDEF";
+    return {nibble_to_hex[byte / 16], nibble_to_hex[byte % 16]};
+}
+
+// @summary writes a quoted and escaped string exactly like dump() does (no ensure_ascii, strict utf-8 handling)
+template <typename Sink> void write_escaped(Sink &sink, std::string_view s)
+{
+    constexpr const char *nibble_to_hex = "0123456789abcdef";
+
+    sink.put('"');
+    std::size_t unwritten = 0;
+    std::uint8_t state = utf8_accept;
+    for (std::size_t i = 0; i < s.size(); ++i)
+    {
+        const auto byte = static_cast<std::uint8_t>(s[i]);
+        if (byte >= 0x80 || state != utf8_accept)
+        {
+            state = utf8_decode(state, byte);
+            if (state == utf8_reject)
+                throw nlohmann::detail::type_error::create(
+                    316,
+                    nlohmann::detail::concat("invalid UTF-8 byte at index ", std::to_string(i), ": 0x", hex_byte(byte)),
+                    nullptr);
+            continue;
+        }
+
+        if (byte >= 0x20 && byte != '"' && byte != '\\')
+            continue;
+
+        sink.put(s.substr(unwritten, i - unwritten));
+        unwritten = i + 1;
+        switch (byte)
+        {
+        case '\b':
+            sink.put("\\b");
+            break;
+        case '\t':
+            sink.put("\\t");
+            break;
+        case '\n':
+            sink.put("\\n");
+            break;
+        case '\f':
+            sink.put("\\f");
+            break;
+        case '\r':
+            sink.put("\\r");
+            break;
+        case '"':
+            sink.put("\\\"");
+            break;
+        case '\\':
+            sink.put("\\\\");
+            break;
+        default:
+            const char escaped[] = {'\\', 'u', '0', '0', nibble_to_hex[byte / 16], nibble_to_hex[byte % 16]};
+            sink.put(std::string_view(escaped, sizeof(escaped)));
+        }
+    }
+
+    if (state != utf8_accept)
+        throw nlohmann::detail::type_error::create(
+            316,
+            nlohmann::detail::concat("incomplete UTF-8 string; last byte: 0x",
+                                     hex_byte(static_cast<std::uint8_t>(s.back()))),
+            nullptr);
+
+    sink.put(s.substr(unwritten));
+    sink.put('"');
+}
+
+// @summary describes how a T is written, the default converts the value to a json and dumps it, so every type which
+// works with to_json works here too
+template <typename T, typename = void> struct json_writer
+{
+    template <typename Sink> static void write(Sink &sink, const T &value)
+    {
+        sink.put(nlohmann::json(value).dump());
+    }
+};
+
+template <typename Sink, typename T> void write_value(Sink &sink, const T &value)
+{
+    json_writer<T>::write(sink, value);
+}
+
+template <typename T> struct json_writer<T, std::enable_if_t<nlohmann::detail::is_basic_json<T>::value>>
+{
+    template <typename Sink> static void write(Sink &sink, const T &value)
+    {
+        sink.put(value.dump());
+    }
+};
+
+template <> struct json_writer<bool>
+{
+    template <typename Sink> static void write(Sink &sink, bool value)
+    {
+        sink.put(value ? "true" : "false");
+    }
+};
+
+template <typename T> struct json_writer<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+{
+    template <typename Sink> static void write(Sink &sink, T value)
+    {
+        std::array<char, 24> buffer{};
+        const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        sink.put(std::string_view(buffer.data(), static_cast<std::size_t>(result.ptr - buffer.data())));
+    }
+};
+
+template <typename T> struct json_writer<T, std::enable_if_t<std::is_floating_point_v<T>>>
+{
+    template <typename Sink> static void write(Sink &sink, T value)
+    {
+        // nlohmann::json stores every floating point as number_float_t and writes NaN and infinity as null
+        const auto number = static_cast<nlohmann::json::number_float_t>(value);
+        if (!std::isfinite(number))
+        {
+            sink.put("null");
+            return;
+        }
+
+        std::array<char, 64> buffer{};
+        const auto *end = nlohmann::detail::to_chars(buffer.data(), buffer.data() + buffer.size(), number);
+        sink.put(std::string_view(buffer.data(), static_cast<std::size_t>(end - buffer.data())));
+    }
+};
+
+template <> struct json_writer<std::string>
+{
+    template <typename Sink> static void write(Sink &sink, const std::string &value)
+    {
+        write_escaped(sink, value);
+    }
+};
+
+template <> struct json_writer<std::string_view>
+{
+    template <typename Sink> static void write(Sink &sink, std::string_view value)
+    {
+        write_escaped(sink, value);
+    }
+};
+
+template <typename T> struct json_writer<T, std::enable_if_t<is_reflected_enum<T>::value>>
+{
+    template <typename Sink> static void write(Sink &sink, T value)
+    {
+        if constexpr (enum_table<T>::reflection.as_integer)
+            write_value(sink, enumerator_index(value));
+        else
+            write_escaped(sink, enumerator_name(value));
+    }
+};
+
+template <typename T> struct json_writer<std::optional<T>>
+{
+    template <typename Sink> static void write(Sink &sink, const std::optional<T> &value)
+    {
+        if (value)
+            write_value(sink, *value);
+        else
+            sink.put("null");
+    }
+};
+
+template <typename... Ts> struct json_writer<std::variant<Ts...>>
+{
+    template <typename Sink> static void write(Sink &sink, const std::variant<Ts...> &value)
+    {
+        std::visit([&sink](const auto &unpacked) { write_value(sink, unpacked); }, value);
+    }
+};
+
+template <typename T, typename Allocator> struct json_writer<std::vector<T, Allocator>>
+{
+    template <typename Sink> static void write(Sink &sink, const std::vector<T, Allocator> &value)
+    {
+        sink.put('[');
+        for (std::size_t i = 0; i < value.size(); ++i)
+        {
+            if (i != 0)
+                sink.put(',');
+            write_value(sink, static_cast<const T &>(value[i]));
+        }
+        sink.put(']');
+    }
+};
+
+// std::map<std::string, ...> is already sorted the same way as the objects of nlohmann::json
+template <typename T, typename Compare, typename Allocator>
+struct json_writer<std::map<std::string, T, Compare, Allocator>,
+                   std::enable_if_t<std::is_same_v<Compare, std::less<std::string>> ||
+                                    std::is_same_v<Compare, std::less<>>>>
+{
+    template <typename Sink> static void write(Sink &sink, const std::map<std::string, T, Compare, Allocator> &value)
+    {
+        sink.put('{');
+        bool first = true;
+        for (const auto &[key, element] : value)
+        {
+            if (!first)
+                sink.put(',');
+            first = false;
+
+            write_escaped(sink, key);
+            sink.put(':');
+            write_value(sink, element);
+        }
+        sink.put('}');
+    }
+};
+
+template <typename T> struct json_writer<T, std::enable_if_t<is_reflected<T>::value>>
+{
+    template <typename Sink> static void write(Sink &sink, const T &value)
+    {
+        sink.put('{');
+        write_keys(sink, value, std::make_index_sequence<key_count<T>()>{});
+        sink.put('}');
+    }
+
+  private:
+    template <typename Sink, std::size_t... Is>
+    static void write_keys(Sink &sink, const T &value, std::index_sequence<Is...>)
+    {
+        static constexpr auto order = sorted_key_order<T>();
+
+        ((Is == 0 ? void() : sink.put(','), write_key<order[Is]>(sink, value)), ...);
+    }
+
+    template <std::size_t I, typename Sink> static void write_key(Sink &sink, const T &value)
+    {
+        if constexpr (I == field_count<T>())
+        {
+            sink.put(tag_json_key);
+            write_escaped(sink, T::json_ext_tag);
+        }
+        else
+        {
+            static constexpr auto fields = T::json_ext_fields();
+            // the key is already quoted and followed by a colon
+            sink.put(std::get<I>(fields).json_key);
+            write_value(sink, value.*(std::get<I>(fields).member));
+        }
+    }
+};
+} // namespace detail
+
+// @summary serializes value without building a nlohmann::json, the output is the same as nlohmann::json(value).dump(),
+// appends to out
+template <typename T> void write(const T &value, std::string &out)
+{
+    JSON_EXT_ENCODE_SCOPE(T);
+    [[maybe_unused]] const auto size = out.size();
+    detail::string_sink sink{out};
+    detail::write_value(sink, value);
+    JSON_EXT_COUNT(T, encoded_bytes, out.size() - size);
+}
+
+// @summary serializes value without building a nlohmann::json, the output is the same as nlohmann::json(value).dump(),
+// writes to the output iterator and returns the iterator past the last written character
+template <typename T, typename OutputIt> OutputIt write(const T &value, OutputIt out)
+{
+    JSON_EXT_ENCODE_SCOPE(T);
+    detail::iterator_sink<OutputIt> sink{out};
+    detail::write_value(sink, value);
+    return sink.out;
+}
+
+// @summary the same as nlohmann::json(value).dump(), but without the nlohmann::json in between
+template <typename T> std::string dump(const T &value)
+{
+    std::string out;
+    write(value, out);
+    return out;
+}
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// BORROWED DESERIALIZATION
+namespace json_ext
+{
+namespace detail
+{
+inline int hex_digit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+// @summary the code unit of the 4 hex digits at content[pos], -1 if they aren't hex digits
+inline long read_code_unit(std::string_view content, std::size_t pos)
+{
+    if (pos + 4 > content.size())
+        return -1;
+
+    long unit = 0;
+    for (std::size_t i = pos; i < pos + 4; ++i)
+    {
+        const int digit = hex_digit(content[i]);
+        if (digit < 0)
+            return -1;
+        unit = unit * 16 + digit;
+    }
+    return unit;
+}
+
+// @summary true if the content of a json string (without its quotes) can be used as it is: no escapes, no control
+// characters and valid utf-8
+inline bool is_plain_string(std::string_view content)
+{
+    std::uint8_t state = utf8_accept;
+    for (const char c : content)
+    {
+        const auto byte = static_cast<std::uint8_t>(c);
+        if (byte == '\\' || byte < 0x20)
+            return false;
+        if (byte >= 0x80 || state != utf8_accept)
+        {
+            state = utf8_decode(state, byte);
+            if (state == utf8_reject)
+                return false;
+        }
+    }
+    return state == utf8_accept;
+}
+
+// @summary unescapes the content of a json string (without its quotes) into out, which has room for content.size()
+// bytes, an escape is never shorter than the utf-8 it stands for. Returns the unescaped size, npos if content isn't a
+// valid json string
+inline std::size_t unescape_string(std::string_view content, char *out)
+{
+    std::size_t size = 0;
+    std::uint8_t state = utf8_accept;
+    for (std::size_t i = 0; i < content.size(); ++i)
+    {
+        const auto byte = static_cast<std::uint8_t>(content[i]);
+        if (byte < 0x20)
+            return npos;
+
+        if (byte != '\\')
+        {
+            state = utf8_decode(state, byte);
+            if (state == utf8_reject)
+                return npos;
+            out[size++] = content[i];
+            continue;
+        }
+
+        if (state != utf8_accept || ++i == content.size())
+            return npos;
+
+        switch (content[i])
+        {
+        case '"':
+        case '\\':
+        case '/':
+            out[size++] = content[i];
+            break;
+        case 'b':
+            out[size++] = '\b';
+            break;
+        case 'f':
+            out[size++] = '\f';
+            break;
+        case 'n':
+            out[size++] = '\n';
+            break;
+        case 'r':
+            out[size++] = '\r';
+            break;
+        case 't':
+            out[size++] = '\t';
+            break;
+        case 'u': {
+            long code_point = read_code_unit(content, i + 1);
+            i += 4;
+            if (code_point < 0 || (code_point >= 0xDC00 && code_point <= 0xDFFF))
+                return npos;
+
+            // a high surrogate has to be followed by an escaped low surrogate
+            if (code_point >= 0xD800 && code_point <= 0xDBFF)
+            {
+                if (i + 2 >= content.size() || content[i + 1] != '\\' || content[i + 2] != 'u')
+                    return npos;
+                const long low = read_code_unit(content, i + 3);
+                if (low < 0xDC00 || low > 0xDFFF)
+                    return npos;
+                code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                i += 6;
+            }
+
+            if (code_point < 0x80)
+                out[size++] = static_cast<char>(code_point);
+            else if (code_point < 0x800)
+            {
+                out[size++] = static_cast<char>(0xC0 | (code_point >> 6));
+                out[size++] = static_cast<char>(0x80 | (code_point & 0x3F));
+            }
+            else if (code_point < 0x10000)
+            {
+                out[size++] = static_cast<char>(0xE0 | (code_point >> 12));
+                out[size++] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                out[size++] = static_cast<char>(0x80 | (code_point & 0x3F));
+            }
+            else
+            {
+                out[size++] = static_cast<char>(0xF0 | (code_point >> 18));
+                out[size++] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+                out[size++] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+                out[size++] = static_cast<char>(0x80 | (code_point & 0x3F));
+            }
+            break;
+        }
+        default:
+            return npos;
+        }
+    }
+    return state == utf8_accept ? size : npos;
+}
+
+inline std::string_view copy_to_arena(std::string_view value, std::pmr::memory_resource &arena)
+{
+    auto *data = static_cast<char *>(arena.allocate(std::max<std::size_t>(value.size(), 1), alignof(char)));
+    std::memcpy(data, value.data(), value.size());
+    return {data, value.size()};
+}
+
+// @summary the string token (with its quotes) as view into the input, or into arena if it has to be unescaped
+inline std::string_view borrow_string(std::string_view token, std::pmr::memory_resource &arena)
+{
+    const auto content = token.substr(1, token.size() - 2);
+    if (is_plain_string(content))
+        return content;
+
+    auto *data = static_cast<char *>(arena.allocate(std::max<std::size_t>(content.size(), 1), alignof(char)));
+    const auto size = unescape_string(content, data);
+    if (size != npos)
+        return {data, size};
+
+    // let nlohmann::json throw its error for the invalid string
+    return copy_to_arena(parse_into<std::string>(token), arena);
+}
+
+// @summary the same as skip_value, but the skipped value is checked as nlohmann::json::parse checks it. Plain strings
+// and scalars are checked in place, containers and escaped strings by nlohmann::json::accept
+inline std::size_t skip_checked_value(std::string_view input, std::size_t pos)
+{
+    const auto end = skip_value(input, pos);
+    const auto token = input.substr(pos, end - pos);
+
+    bool valid;
+    if (token.empty())
+        valid = false;
+    else if (token.front() == '"')
+        valid =
+            is_plain_string(token.substr(1, token.size() - 2)) || nlohmann::json::accept(token.begin(), token.end());
+    else if (token.front() == '{' || token.front() == '[')
+        valid = nlohmann::json::accept(token.begin(), token.end());
+    else
+        valid = is_valid_json(token);
+
+    if (!valid)
+        throw_scan_error(pos, "invalid value");
+    return end;
+}
+
+[[noreturn]] inline void throw_borrowed_type_error(const char *expected, char first)
+{
+    throw nlohmann::detail::type_error::create(
+        302, nlohmann::detail::concat("type must be ", expected, ", but is ", scanned_type_name(first)), nullptr);
+}
+
+// @summary decodes the value at input[pos] into value and returns the position after it. The default decodes the raw
+// value with parse_into, the specializations borrow strings from input
+template <typename T, typename = void> struct borrower
+{
+    static std::size_t decode(std::string_view input, std::size_t pos, T &value, std::pmr::memory_resource &)
+    {
+        const auto end = skip_value(input, pos);
+        parse_into(input.substr(pos, end - pos), value);
+        return end;
+    }
+};
+
+template <typename T>
+std::size_t borrow_value(std::string_view input, std::size_t pos, T &value, std::pmr::memory_resource &arena)
+{
+    return borrower<T>::decode(input, pos, value, arena);
+}
+
+template <> struct borrower<std::string_view>
+{
+    static std::size_t decode(std::string_view input, std::size_t pos, std::string_view &value,
+                              std::pmr::memory_resource &arena)
+    {
+        if (input[pos] != '"')
+            throw_borrowed_type_error("string", input[pos]);
+
+        const auto end = skip_string(input, pos);
+        value = borrow_string(input.substr(pos, end - pos), arena);
+        return end;
+    }
+};
+
+// std::string members are still owned, but copied straight from the input when they have no escapes
+template <> struct borrower<std::string>
+{
+    static std::size_t decode(std::string_view input, std::size_t pos, std::string &value,
+                              std::pmr::memory_resource &)
+    {
+        if (input[pos] != '"')
+            throw_borrowed_type_error("string", input[pos]);
+
+        const auto end = skip_string(input, pos);
+        const auto token = input.substr(pos, end - pos);
+        if (is_plain_string(token.substr(1, token.size() - 2)))
+            value.assign(token.substr(1, token.size() - 2));
+        else
+            parse_into(token, value);
+        return end;
+    }
+};
+
+template <typename T> struct borrower<std::optional<T>>
+{
+    static std::size_t decode(std::string_view input, std::size_t pos, std::optional<T> &value,
+                              std::pmr::memory_resource &arena)
+    {
+        if (input[pos] == 'n')
+        {
+            // parse_into rejects everything else than null
+            std::nullptr_t null;
+            value.reset();
+            return borrow_value(input, pos, null, arena);
+        }
+
+        if (!value)
+            value.emplace();
+        return borrow_value(input, pos, *value, arena);
+    }
+};
+
+template <typename T, typename Allocator>
+struct borrower<std::vector<T, Allocator>, std::enable_if_t<!std::is_same_v<T, bool>>>
+{
+    static std::size_t decode(std::string_view input, std::size_t pos, std::vector<T, Allocator> &value,
+                              std::pmr::memory_resource &arena)
+    {
+        if (input[pos] != '[')
+            throw_borrowed_type_error("array", input[pos]);
+
+        value.clear();
+        return scan_array(input, pos, [&](std::size_t element) {
+            return borrow_value(input, element, value.emplace_back(), arena);
+        });
+    }
+};
+
+template <typename T> struct borrower<T, std::enable_if_t<is_reflected<T>::value>>
+{
+    static std::size_t decode(std::string_view input, std::size_t pos, T &value, std::pmr::memory_resource &arena)
+    {
+        if (input[pos] != '{')
+            throw_not_an_object<T>(scanned_type_name(input[pos]));
+
+        std::bitset<field_count<T>()> seen;
+        key_precedence<T> precedence;
+        pos = scan_object(input, pos, [&](std::string_view quoted_key, std::size_t value_begin) {
+            bool is_alias;
+            const auto index = scanned_key_index<T>(quoted_key, is_alias);
+            if (index < field_count<T>() && precedence.accept(index, is_alias))
+            {
+                seen.set(index);
+                return decode_field(input, value_begin, value, arena, index,
+                                    std::make_index_sequence<field_count<T>()>{});
+            }
+
+            // unknown keys and keys which lose to a duplicate are skipped, but their value still has to be valid
+            const auto value_end = skip_checked_value(input, value_begin);
+            if (index != npos)
+                check_scanned_tag<T>(input.substr(value_begin, value_end - value_begin));
+            return value_end;
+        });
+
+        // the same as the generated from_json, missing members are either defaulted or the key is required
+        std::apply(
+            [&](const auto &...fields) {
+                std::size_t i = 0;
+                (finish_field(fields, value, seen.test(i++)), ...);
+            },
+            T::json_ext_fields());
+        return pos;
+    }
+
+  private:
+    template <std::size_t... Is>
+    static std::size_t decode_field(std::string_view input, std::size_t pos, T &value, std::pmr::memory_resource &arena,
+                                    std::size_t index, std::index_sequence<Is...>)
+    {
+        static constexpr auto fields = T::json_ext_fields();
+
+        std::size_t end = pos;
+        ((index == Is && (end = borrow_value(input, pos, value.*(std::get<Is>(fields).member), arena), true)) || ...);
+        return end;
+    }
+
+    template <typename Field> static void finish_field(const Field &field, T &value, bool seen)
+    {
+        if (seen)
+            return;
+
+        if constexpr (Field::has_default)
+            field.set_default(value);
+        else
+            throw nlohmann::detail::out_of_range::create(
+                403, nlohmann::detail::concat("key '", std::string(field.name), "' not found"), nullptr);
+    }
+};
+} // namespace detail
+
+// @summary decodes input into value like parse_into, but std::string_view members are not copied: they point into
+// input, or into arena if they contain escapes which have to be decoded. value is only valid as long as input and
+// arena are, use it for short-lived objects, e.g. with a per-request std::pmr::monotonic_buffer_resource as arena.
+// Reflected types, optionals, vectors and strings are decoded directly from the raw text, every other member with
+// parse_into.
+// Accepts and rejects the same json as parse_into, values under unknown keys included, but members which are string
+// views can't be decoded by from_json (they would point into a temporary nlohmann::json)
+template <typename T> void parse_borrowed(std::string_view input, T &value, std::pmr::memory_resource &arena)
+{
+    JSON_EXT_DECODE_SCOPE(T);
+    JSON_EXT_COUNT(T, decoded_bytes, input.size());
+    const auto pos = detail::skip_whitespace(input, 0);
+    if (pos == input.size())
+        detail::throw_scan_error(pos, "unexpected end of input, expected a value");
+
+    try
+    {
+        detail::expect_end(input, detail::borrow_value(input, pos, value, arena));
+    }
+    catch (const nlohmann::json::parse_error &)
+    {
+        // the values are parsed one by one, report the syntax error with its position in the whole input
+        [[maybe_unused]] const auto reparsed = nlohmann::json::parse(input);
+        throw;
+    }
+}
+
+template <typename T> T parse_borrowed(std::string_view input, std::pmr::memory_resource &arena)
+{
+    T value;
+    parse_borrowed(input, value, arena);
+    return value;
+}
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// DELTA SERIALIZATION
+namespace json_ext
+{
+namespace detail
+{
+template <typename T, typename = void> struct has_equal : std::false_type
+{
+};
+
+template <typename T>
+struct has_equal<T, std::void_t<decltype(std::declval<const T &>() == std::declval<const T &>())>> : std::true_type
+{
+};
+
+// @summary compares two values the way they would compare as json, reflected types are compared member by member, so
+// they don't need an operator==. Types without operator== are compared as json
+template <typename T, typename = void> struct value_equal
+{
+    static bool equal(const T &lhs, const T &rhs)
+    {
+        if constexpr (has_equal<T>::value)
+            return lhs == rhs;
+        else
+            return nlohmann::json(lhs) == nlohmann::json(rhs);
+    }
+};
+
+template <typename T> bool equal(const T &lhs, const T &rhs)
+{
+    return value_equal<T>::equal(lhs, rhs);
+}
+
+// @summary NaN equals NaN and 0.0 differs from -0.0, like their json (null, "0.0" and "-0.0"), so an unchanged NaN
+// member isn't written to every diff
+template <typename T> struct value_equal<T, std::enable_if_t<std::is_floating_point_v<T>>>
+{
+    static bool equal(T lhs, T rhs)
+    {
+        if (std::isnan(lhs))
+            return std::isnan(rhs);
+        return lhs == rhs && std::signbit(lhs) == std::signbit(rhs);
+    }
+};
+
+template <typename T> struct value_equal<std::optional<T>>
+{
+    static bool equal(const std::optional<T> &lhs, const std::optional<T> &rhs)
+    {
+        return lhs.has_value() == rhs.has_value() && (!lhs || json_ext::detail::equal(*lhs, *rhs));
+    }
+};
+
+template <typename... Ts> struct value_equal<std::variant<Ts...>>
+{
+    static bool equal(const std::variant<Ts...> &lhs, const std::variant<Ts...> &rhs)
+    {
+        if (lhs.index() != rhs.index())
+            return false;
+
+        return std::visit(
+            [&rhs](const auto &unpacked) {
+                using T = std::decay_t<decltype(unpacked)>;
+                return json_ext::detail::equal(unpacked, *std::get_if<T>(&rhs));
+            },
+            lhs);
+    }
+};
+
+template <typename T, typename Allocator> struct value_equal<std::vector<T, Allocator>>
+{
+    static bool equal(const std::vector<T, Allocator> &lhs, const std::vector<T, Allocator> &rhs)
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+            if (!json_ext::detail::equal(static_cast<const T &>(lhs[i]), static_cast<const T &>(rhs[i])))
+                return false;
+        return true;
+    }
+};
+
+template <typename T> struct value_equal<T, std::enable_if_t<is_reflected<T>::value>>
+{
+    static bool equal(const T &lhs, const T &rhs)
+    {
+        return std::apply(
+            [&](const auto &...fields) {
+                return (json_ext::detail::equal(lhs.*(fields.member), rhs.*(fields.member)) && ...);
+            },
+            T::json_ext_fields());
+    }
+};
+
+// @summary members which are patched member by member instead of being replaced: reflected types and engaged optionals
+// of reflected types
+template <typename T> struct is_patchable : is_reflected<T>
+{
+};
+
+template <typename T> struct is_patchable<std::optional<T>> : is_reflected<T>
+{
+};
+
+template <typename T> const T &patch_target(const T &value)
+{
+    return value;
+}
+
+template <typename T> const T &patch_target(const std::optional<T> &value)
+{
+    return *value;
+}
+
+template <typename T> T &patch_target(T &value)
+{
+    return value;
+}
+
+template <typename T> T &patch_target(std::optional<T> &value)
+{
+    return *value;
+}
+
+template <typename T> bool has_patch_target(const T &)
+{
+    return true;
+}
+
+template <typename T> bool has_patch_target(const std::optional<T> &value)
+{
+    return value.has_value();
+}
+
+template <typename T> struct delta
+{
+    static constexpr auto fields = T::json_ext_fields();
+
+    // @summary adds the changed members of current to patch
+    template <typename BasicJsonType> static void diff(const T &baseline, const T &current, BasicJsonType &patch)
+    {
+        diff(baseline, current, patch, std::make_index_sequence<field_count<T>()>{});
+    }
+
+    // @summary writes the changed members of current as object, in the same order as diff(...).dump()
+    template <typename Sink> static void write(Sink &sink, const T &baseline, const T &current)
+    {
+        sink.put('{');
+        bool first = true;
+        write(sink, baseline, current, first, std::make_index_sequence<key_count<T>()>{});
+        sink.put('}');
+    }
+
+    template <typename BasicJsonType> static void apply(T &value, BasicJsonType &patch)
+    {
+        if (!patch.is_object())
+            throw nlohmann::detail::type_error::create(
+                302, nlohmann::detail::concat("type must be object, but is ", patch.type_name()), &patch);
+
+        from_json_tag<T>(patch);
+        for (auto it = patch.begin(); it != patch.end(); ++it)
+        {
+            bool is_alias;
+            const auto index = field_index<T>(it.key(), is_alias);
+            if (index < field_count<T>())
+            {
+                // the object has no order of its keys, so the alias is skipped if the name is present at all
+                if (!is_alias || !patch.contains(typename BasicJsonType::object_t::key_type(key_names<T>()[index])))
+                    apply(value, index, *it, std::make_index_sequence<field_count<T>()>{});
+            }
+            else if (index == npos && T::json_ext_strict)
+            {
+                throw_unknown_key<T>(patch, it.key());
+            }
+        }
+    }
+
+  private:
+    template <typename BasicJsonType, std::size_t... Is>
+    static void diff(const T &baseline, const T &current, BasicJsonType &patch, std::index_sequence<Is...>)
+    {
+        (diff_field<Is>(baseline, current, patch), ...);
+    }
+
+    template <std::size_t I, typename BasicJsonType>
+    static void diff_field(const T &baseline, const T &current, BasicJsonType &patch)
+    {
+        const auto &field = std::get<I>(fields);
+        const auto &before = baseline.*(field.member);
+        const auto &after = current.*(field.member);
+        using member_type = std::decay_t<decltype(after)>;
+
+        if (json_ext::detail::equal(before, after))
+            return;
+
+        auto &changed = patch[typename BasicJsonType::object_t::key_type(field.name)];
+        if constexpr (is_patchable<member_type>::value)
+        {
+            if (has_patch_target(before) && has_patch_target(after))
+            {
+                changed = BasicJsonType::object();
+                delta<std::decay_t<decltype(patch_target(after))>>::diff(patch_target(before), patch_target(after),
+                                                                         changed);
+                return;
+            }
+        }
+        changed = after;
+    }
+
+    template <typename Sink, std::size_t... Is>
+    static void write(Sink &sink, const T &baseline, const T &current, bool &first, std::index_sequence<Is...>)
+    {
+        static constexpr auto order = sorted_key_order<T>();
+
+        (write_field<order[Is]>(sink, baseline, current, first), ...);
+    }
+
+    template <std::size_t I, typename Sink>
+    static void write_field(Sink &sink, const T &baseline, const T &current, bool &first)
+    {
+        // the tag never changes
+        if constexpr (I < field_count<T>())
+        {
+            const auto &field = std::get<I>(fields);
+            const auto &before = baseline.*(field.member);
+            const auto &after = current.*(field.member);
+            using member_type = std::decay_t<decltype(after)>;
+
+            if (json_ext::detail::equal(before, after))
+                return;
+
+            if (!first)
+                sink.put(',');
+            first = false;
+            // the key is already quoted and followed by a colon
+            sink.put(field.json_key);
+
+            if constexpr (is_patchable<member_type>::value)
+            {
+                if (has_patch_target(before) && has_patch_target(after))
+                {
+                    delta<std::decay_t<decltype(patch_target(after))>>::write(sink, patch_target(before),
+                                                                              patch_target(after));
+                    return;
+                }
+            }
+            write_value(sink, after);
+        }
+    }
+
+    template <typename BasicJsonType, std::size_t... Is>
+    static void apply(T &value, std::size_t index, BasicJsonType &patch, std::index_sequence<Is...>)
+    {
+        ((index == Is && (apply_field<Is>(value, patch), true)) || ...);
+    }
+
+    template <std::size_t I, typename BasicJsonType> static void apply_field(T &value, BasicJsonType &patch)
+    {
+        auto &member = value.*(std::get<I>(fields).member);
+        using member_type = std::decay_t<decltype(member)>;
+
+        // a nested object patches the members of an existing value, everything else replaces the member
+        if constexpr (is_patchable<member_type>::value)
+        {
+            if (patch.is_object() && has_patch_target(member))
+            {
+                delta<std::decay_t<decltype(patch_target(member))>>::apply(patch_target(member), patch);
+                return;
+            }
+        }
+        json_ext::detail::extract(patch, member);
+    }
+};
+} // namespace detail
+
+// @summary the members of current which differ from baseline as RFC 7386 merge patch: changed members of reflected
+// types (and of engaged optionals of reflected types) are diffed member by member, every other changed member is
+// written as a whole. The members are visited by their compile time index, only their values are compared. A member
+// which changes to null (e.g. an empty optional) is written as null, a generic merge patch removes the key instead
+template <typename BasicJsonType = nlohmann::json, typename T> BasicJsonType diff(const T &baseline, const T &current)
+{
+    static_assert(detail::is_reflected<T>::value, "diff needs a type defined with NLOHMANN_SERIALIZE");
+
+    auto patch = BasicJsonType::object();
+    detail::delta<T>::diff(baseline, current, patch);
+    return patch;
+}
+
+// @summary the same as diff(baseline, current).dump(), but without the nlohmann::json in between, appends to out
+template <typename T> void write_diff(const T &baseline, const T &current, std::string &out)
+{
+    static_assert(detail::is_reflected<T>::value, "write_diff needs a type defined with NLOHMANN_SERIALIZE");
+
+    detail::string_sink sink{out};
+    detail::delta<T>::write(sink, baseline, current);
+}
+
+// @summary applies a patch created by diff to value in place: the members in patch are updated as with
+// json_ext::update, nested objects patch the members of nested reflected types, all other members stay as they are. If
+// patch is an rvalue it is moved from. If an exception is thrown the members patched before the failing one keep their
+// new values, so value is a mix of the old and the patched state; patch a copy if that matters
+template <typename T, typename BasicJsonType> void apply_patch(T &value, BasicJsonType &&patch)
+{
+    static_assert(detail::is_reflected<T>::value, "apply_patch needs a type defined with NLOHMANN_SERIALIZE");
+    static_assert(nlohmann::detail::is_basic_json<std::decay_t<BasicJsonType>>::value);
+
+    // only an rvalue may be moved from
+    if constexpr (std::is_lvalue_reference_v<BasicJsonType>)
+        detail::delta<T>::apply(value, std::as_const(patch));
+    else
+        detail::delta<T>::apply(value, patch);
+}
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// COMPACT SERIALIZATION
+namespace json_ext
+{
+// @summary what the compact profile leaves out of the json. The result decodes to the same value with j.get<T>(),
+// parse_into, parse_borrowed, ... because only members which get the same value from their declared default are left
+// out, and the aliases are accepted wherever the names are
+struct compact_options
+{
+    // members which are an empty std::optional and whose declared default is std::nullopt as well
+    bool omit_empty_optionals = true;
+    // members which are equal to their declared default, this costs evaluating the default and a comparison per member
+    // with a default
+    bool omit_defaults = false;
+    // the declared aliases are written instead of the names
+    bool use_aliases = true;
+};
+
+namespace detail
+{
+// @summary the keys of T as written by the compact profile, see key_names
+template <typename T, bool UseAliases> constexpr std::array<std::string_view, key_count<T>()> compact_key_names()
+{
+    auto keys = key_names<T>();
+    if constexpr (UseAliases)
+    {
+        const auto aliases = field_aliases<T>();
+        for (std::size_t i = 0; i < aliases.size(); ++i)
+            if (!aliases[i].empty())
+                keys[i] = aliases[i];
+    }
+    return keys;
+}
+
+template <typename T> bool is_empty_optional(const T &)
+{
+    return false;
+}
+
+template <typename T> bool is_empty_optional(const std::optional<T> &value)
+{
+    return !value.has_value();
+}
+
+// @summary the same as json_writer, but reflected types are written with the compact profile, also if they are nested
+// in optionals, variants, vectors or maps
+template <typename T, typename = void> struct compact_writer
+{
+    template <typename Sink> static void write(Sink &sink, const T &value, const compact_options &)
+    {
+        write_value(sink, value);
+    }
+};
+
+template <typename T> struct compact_writer<std::optional<T>>
+{
+    template <typename Sink>
+    static void write(Sink &sink, const std::optional<T> &value, const compact_options &options)
+    {
+        if (value)
+            compact_writer<T>::write(sink, *value, options);
+        else
+            sink.put("null");
+    }
+};
+
+template <typename... Ts> struct compact_writer<std::variant<Ts...>>
+{
+    template <typename Sink>
+    static void write(Sink &sink, const std::variant<Ts...> &value, const compact_options &options)
+    {
+        std::visit(
+            [&](const auto &unpacked) {
+                compact_writer<std::decay_t<decltype(unpacked)>>::write(sink, unpacked, options);
+            },
+            value);
+    }
+};
+
+template <typename T, typename Allocator> struct compact_writer<std::vector<T, Allocator>>
+{
+    template <typename Sink>
+    static void write(Sink &sink, const std::vector<T, Allocator> &value, const compact_options &options)
+    {
+        sink.put('[');
+        for (std::size_t i = 0; i < value.size(); ++i)
+        {
+            if (i != 0)
+                sink.put(',');
+            compact_writer<T>::write(sink, static_cast<const T &>(value[i]), options);
+        }
+        sink.put(']');
+    }
+};
+
+template <typename T, typename Compare, typename Allocator>
+struct compact_writer<std::map<std::string, T, Compare, Allocator>,
+                      std::enable_if_t<std::is_same_v<Compare, std::less<std::string>> ||
+                                       std::is_same_v<Compare, std::less<>>>>
+{
+    template <typename Sink>
+    static void write(Sink &sink, const std::map<std::string, T, Compare, Allocator> &value,
+                      const compact_options &options)
+    {
+        sink.put('{');
+        bool first = true;
+        for (const auto &[key, element] : value)
+        {
+            if (!first)
+                sink.put(',');
+            first = false;
+
+            write_escaped(sink, key);
+            sink.put(':');
+            compact_writer<T>::write(sink, element, options);
+        }
+        sink.put('}');
+    }
+};
+
+template <typename T> struct compact_writer<T, std::enable_if_t<is_reflected<T>::value>>
+{
+    static constexpr auto fields = T::json_ext_fields();
+
+    template <typename Sink> static void write(Sink &sink, const T &value, const compact_options &options)
+    {
+        sink.put('{');
+        bool first = true;
+        if (options.use_aliases)
+            write_keys<true>(sink, value, options, first, std::make_index_sequence<key_count<T>()>{});
+        else
+            write_keys<false>(sink, value, options, first, std::make_index_sequence<key_count<T>()>{});
+        sink.put('}');
+    }
+
+  private:
+    template <bool UseAliases, typename Sink, std::size_t... Is>
+    static void write_keys(Sink &sink, const T &value, const compact_options &options, bool &first,
+                           std::index_sequence<Is...>)
+    {
+        // sorted by the written keys, so the order is the one nlohmann::json would have
+        static constexpr auto order = sorted_order(compact_key_names<T, UseAliases>());
+
+        (write_key<order[Is], UseAliases>(sink, value, options, first), ...);
+    }
+
+    template <std::size_t I, bool UseAliases, typename Sink>
+    static void write_key(Sink &sink, const T &value, const compact_options &options, bool &first)
+    {
+        // the tag is always written, a variant may need it to select the alternative
+        if constexpr (I == field_count<T>())
+        {
+            if (!first)
+                sink.put(',');
+            first = false;
+            sink.put(tag_json_key);
+            write_escaped(sink, T::json_ext_tag);
+        }
+        else
+        {
+            const auto &field = std::get<I>(fields);
+            const auto &member = value.*(field.member);
+            if (is_omitted(field, value, member, options))
+                return;
+
+            if (!first)
+                sink.put(',');
+            first = false;
+            // the key is already quoted and followed by a colon
+            sink.put(UseAliases && !field.alias.empty() ? field.json_alias_key : field.json_key);
+            compact_writer<std::decay_t<decltype(member)>>::write(sink, member, options);
+        }
+    }
+
+    // only a member with a declared default may be missing, it gets the default back when the json is decoded. The
+    // default is evaluated on value, as decoding evaluates it on the decoded object, and only if an option needs it
+    template <typename Field, typename Member>
+    static bool is_omitted(const Field &field, const T &value, const Member &member, const compact_options &options)
+    {
+        if constexpr (Field::has_default)
+        {
+            // an empty optional equals an empty default, omit_defaults covers omit_empty_optionals
+            if (options.omit_defaults)
+                return json_ext::detail::equal(member, field.default_value(value));
+
+            return options.omit_empty_optionals && is_empty_optional(member) &&
+                   is_empty_optional(field.default_value(value));
+        }
+        else
+            return false;
+    }
+};
+} // namespace detail
+
+// @summary serializes value without building a nlohmann::json as write does, but leaves out the members options allows
+// to omit and writes the declared aliases as keys (see compact_options), appends to out
+template <typename T> void write_compact(const T &value, std::string &out, const compact_options &options = {})
+{
+    JSON_EXT_ENCODE_SCOPE(T);
+    [[maybe_unused]] const auto size = out.size();
+    detail::string_sink sink{out};
+    detail::compact_writer<T>::write(sink, value, options);
+    JSON_EXT_COUNT(T, encoded_bytes, out.size() - size);
+}
+
+// @summary the same as dump, but with the compact profile, see write_compact
+template <typename T> std::string dump_compact(const T &value, const compact_options &options = {})
+{
+    std::string out;
+    write_compact(value, out, options);
+    return out;
+}
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// COLUMNAR CONTAINERS
+namespace json_ext
+{
+// @summary one bit per row, packed into 64 bit words so a filter can test or combine 64 rows at once
+class presence_bitmap
+{
+  public:
+    bool test(std::size_t row) const
+    {
+        return (words_[row / 64] >> (row % 64)) & 1;
+    }
+
+    void push_back(bool present)
+    {
+        if (size_ % 64 == 0)
+            words_.push_back(0);
+        words_.back() |= std::uint64_t{present} << (size_ % 64);
+        ++size_;
+    }
+
+    // @summary the number of set bits
+    std::size_t count() const
+    {
+        std::size_t count = 0;
+        for (auto word : words_)
+            for (; word != 0; word &= word - 1)
+                ++count;
+        return count;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    // @summary the bits of row i are in words()[i / 64] at bit i % 64, the unused bits of the last word are zero
+    const std::vector<std::uint64_t> &words() const
+    {
+        return words_;
+    }
+
+    void reserve(std::size_t rows)
+    {
+        words_.reserve((rows + 63) / 64);
+    }
+
+    void clear()
+    {
+        words_.clear();
+        size_ = 0;
+    }
+
+  private:
+    std::vector<std::uint64_t> words_;
+    std::size_t size_ = 0;
+};
+
+template <typename T> class columns;
+
+// @summary the element of a bool column: std::vector<bool> packs the rows into bits, which are neither contiguous bools
+// nor addressable, one byte per row keeps the column a plain array. Converts from and to bool
+struct column_bool
+{
+    bool value = false;
+
+    column_bool() = default;
+
+    column_bool(bool value) : value(value)
+    {
+    }
+
+    operator bool() const
+    {
+        return value;
+    }
+};
+
+static_assert(sizeof(column_bool) == 1);
+
+namespace detail
+{
+// @summary the element type of the column of a member, an optional is stored unwrapped next to a presence bitmap. The
+// column stores storage_type, which is type except for bool
+template <typename T> struct column_element
+{
+    using type = T;
+    using storage_type = std::conditional_t<std::is_same_v<T, bool>, column_bool, T>;
+    static constexpr bool is_optional = false;
+};
+
+template <typename T> struct column_element<std::optional<T>> : column_element<T>
+{
+    static constexpr bool is_optional = true;
+};
+
+template <typename T, std::size_t I>
+using field_column_element =
+    column_element<typename std::tuple_element_t<I, decltype(T::json_ext_fields())>::member_type>;
+
+template <typename T, typename Indices> struct column_tuple;
+
+template <typename T, std::size_t... Is> struct column_tuple<T, std::index_sequence<Is...>>
+{
+    using type = std::tuple<std::vector<typename field_column_element<T, Is>::storage_type>...>;
+};
+
+// @summary members which are optional or have a declared default get a presence bitmap: an optional is present if it
+// holds a value, every other member if its key was in the json (or the row was added as a T)
+template <typename T, std::size_t I> constexpr bool has_presence()
+{
+    return field_column_element<T, I>::is_optional ||
+           std::tuple_element_t<I, decltype(T::json_ext_fields())>::has_default;
+}
+
+template <typename T> class sax_columns_row_frame;
+} // namespace detail
+
+// @summary the rows of an array of reflected T stored as struct of arrays: one contiguous std::vector per member in
+// declaration order, so a scan over one member only touches that member. Optional members are stored unwrapped (an
+// empty optional as a value initialized element), their presence bitmap tells which rows hold a value. A bool member
+// is stored as column_bool, one byte per row instead of the bits of std::vector<bool>. The columns are
+// read only, rows are added with push_back or by decoding with parse_into, j.get or json_ext::update. If decoding
+// throws the columns are cleared
+template <typename T> class columns
+{
+    static_assert(detail::is_reflected<T>::value, "columns needs a type defined with NLOHMANN_SERIALIZE");
+
+    static constexpr std::size_t field_count = detail::field_count<T>();
+    using fields_type = decltype(T::json_ext_fields());
+    using indices = std::make_index_sequence<field_count>;
+
+  public:
+    using value_type = T;
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    // @summary the column of the member, e.g. trades.column<&Trade::price>() is a const std::vector<double>&, the one
+    // of a bool member a const std::vector<column_bool>&
+    template <auto Member> const auto &column() const
+    {
+        constexpr auto index = detail::member_index<T, Member>();
+        static_assert(index != detail::npos, "the member isn't reflected by NLOHMANN_SERIALIZE");
+        return std::get<index>(columns_);
+    }
+
+    // @summary which rows hold the member, only for optional members and members with a declared default
+    template <auto Member> const presence_bitmap &presence() const
+    {
+        constexpr auto index = detail::member_index<T, Member>();
+        static_assert(index != detail::npos, "the member isn't reflected by NLOHMANN_SERIALIZE");
+        static_assert(detail::has_presence<T, index>(), "only optional members and members with default have one");
+        return presence_[index];
+    }
+
+    // @summary reassembles row i
+    T row(std::size_t i) const
+    {
+        T value;
+        get_row(i, value, indices{});
+        return value;
+    }
+
+    void push_back(const T &value)
+    {
+        push_row(value, indices{});
+    }
+
+    void push_back(T &&value)
+    {
+        push_row(std::move(value), indices{});
+    }
+
+    void reserve(std::size_t rows)
+    {
+        std::apply([rows](auto &...columns) { (columns.reserve(rows), ...); }, columns_);
+        for (auto &presence : presence_)
+            presence.reserve(rows);
+    }
+
+    void clear()
+    {
+        std::apply([](auto &...columns) { (columns.clear(), ...); }, columns_);
+        for (auto &presence : presence_)
+            presence.clear();
+        size_ = 0;
+    }
+
+    // @summary the same as j.get<std::vector<T>>() turned into columns, every row is decoded with the from_json of T
+    template <typename BasicJsonType,
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>
+    friend void from_json(const BasicJsonType &j, columns &value)
+    {
+        value.clear();
+        if (!j.is_array())
+            throw nlohmann::detail::type_error::create(
+                302, nlohmann::detail::concat("type must be array, but is ", j.type_name()), &j);
+
+        value.reserve(j.size());
+        try
+        {
+            for (const auto &element : j)
+            {
+                T row = element.template get<T>();
+                value.push_row(std::move(row), indices{}, [&element](const auto &field) {
+                    return element.find(field.name) != element.end() ||
+                           (!field.alias.empty() && element.find(field.alias) != element.end());
+                });
+            }
+        }
+        catch (...)
+        {
+            value.clear();
+            throw;
+        }
+    }
+
+    // @summary the same json as for the std::vector<T> of the rows
+    template <typename BasicJsonType,
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>
+    friend void to_json(BasicJsonType &j, const columns &value)
+    {
+        j = BasicJsonType::array();
+        for (std::size_t i = 0; i < value.size(); ++i)
+            j.push_back(BasicJsonType(value.row(i)));
+    }
+
+  private:
+    friend class detail::sax_columns_row_frame<T>;
+
+    template <std::size_t... Is> void get_row(std::size_t i, T &value, std::index_sequence<Is...>) const
+    {
+        static constexpr auto fields = T::json_ext_fields();
+        (get_member<Is>(i, value.*(std::get<Is>(fields).member)), ...);
+    }
+
+    template <std::size_t I, typename Member> void get_member(std::size_t i, Member &member) const
+    {
+        const auto &column = std::get<I>(columns_);
+        using element_type = typename detail::field_column_element<T, I>::type;
+        if constexpr (detail::field_column_element<T, I>::is_optional)
+        {
+            if (presence_[I].test(i))
+                member = static_cast<const element_type &>(column[i]);
+            else
+                member.reset();
+        }
+        else
+            member = static_cast<const element_type &>(column[i]);
+    }
+
+    // without a key lookup every member of a T counts as given
+    template <typename Row, std::size_t... Is> void push_row(Row &&value, std::index_sequence<Is...> indices)
+    {
+        push_row(std::forward<Row>(value), indices, [](const auto &) { return true; });
+    }
+
+    template <typename Row, std::size_t... Is, typename HasKey>
+    void push_row(Row &&value, std::index_sequence<Is...>, const HasKey &has_key)
+    {
+        static constexpr auto fields = T::json_ext_fields();
+        (push_member<Is>(std::forward<Row>(value).*(std::get<Is>(fields).member), has_key(std::get<Is>(fields))),
+         ...);
+        ++size_;
+    }
+
+    template <std::size_t I, typename Member> void push_member(Member &&member, bool has_key)
+    {
+        auto &column = std::get<I>(columns_);
+        if constexpr (detail::field_column_element<T, I>::is_optional)
+        {
+            presence_[I].push_back(member.has_value());
+            if (member)
+                column.push_back(*std::forward<Member>(member));
+            else
+                column.emplace_back();
+        }
+        else
+        {
+            if constexpr (detail::has_presence<T, I>())
+                presence_[I].push_back(has_key);
+            column.push_back(std::forward<Member>(member));
+        }
+    }
+
+    typename detail::column_tuple<T, indices>::type columns_;
+    // the bitmaps of members without presence stay empty
+    std::array<presence_bitmap, field_count> presence_;
+    std::size_t size_ = 0;
+};
+
+template <typename T> struct probe<columns<T>> : probe<std::vector<T>>
+{
+};
+
+namespace detail
+{
+// @summary parses one object of the array into the next row of the columns, the same as sax_object_frame does for a T
+template <typename T> class sax_columns_row_frame : public sax_frame
+{
+  public:
+    sax_columns_row_frame(columns<T> &target, std::optional<T> &prototype) : target_(target), prototype_(prototype)
+    {
+        std::apply([](auto &...columns) { (columns.emplace_back(), ...); }, target_.columns_);
+    }
+
+    void key(nlohmann::json::string_t &key) override
+    {
+        bool is_alias;
+        current_ = field_index<T>(key, is_alias);
+        if (current_ == npos && T::json_ext_strict)
+        {
+            JSON_EXT_COUNT(T, strict_rejections, 1);
+            throw nlohmann::detail::other_error::create(
+                600, nlohmann::detail::concat("key '", key, "' not present in reflected keys"), nullptr);
+        }
+        // an alias after the name of its field is skipped
+        if (!precedence_.accept(current_, is_alias))
+            current_ = npos;
+    }
+
+    std::unique_ptr<sax_frame> value(sax_event &event) override
+    {
+        if (current_ == npos)
+            return event.is_scalar() ? nullptr : std::make_unique<sax_skip_frame>();
+
+        if constexpr (is_tagged<T>::value)
+        {
+            if (current_ == field_count<T>())
+            {
+                if (event.type != sax_event::kind::string || *event.string != T::json_ext_tag)
+                    throw_tag_mismatch(T::json_ext_tag, event.is_scalar() ? event.to_json().dump() : event.type_name());
+                return nullptr;
+            }
+        }
+
+        seen_.set(current_);
+        return parse_field(event, std::make_index_sequence<field_count<T>()>{});
+    }
+
+    bool end(bool) override
+    {
+        finish_fields(std::make_index_sequence<field_count<T>()>{});
+        ++target_.size_;
+        return true;
+    }
+
+  private:
+    template <std::size_t... Is>
+    std::unique_ptr<sax_frame> parse_field(sax_event &event, std::index_sequence<Is...>)
+    {
+        std::unique_ptr<sax_frame> frame;
+        ((current_ == Is && (frame = parse_element<Is>(event), true)) || ...);
+        return frame;
+    }
+
+    template <std::size_t I> std::unique_ptr<sax_frame> parse_element(sax_event &event)
+    {
+        using element_type = typename field_column_element<T, I>::type;
+        auto &column = std::get<I>(target_.columns_);
+
+        // null is an empty optional, the element is reset in case of a duplicate key
+        present_.set(I, !field_column_element<T, I>::is_optional || event.type != sax_event::kind::null);
+        if (!present_.test(I))
+        {
+            column.back() = element_type{};
+            return nullptr;
+        }
+
+        if constexpr (std::is_same_v<element_type, bool>)
+            return sax_parse_value(column.back().value, event);
+        else
+            return sax_parse_value(column.back(), event);
+    }
+
+    template <std::size_t... Is> void finish_fields(std::index_sequence<Is...>)
+    {
+        (finish_field<Is>(), ...);
+    }
+
+    // the same as the generated from_json, missing members are either defaulted or the key is required
+    template <std::size_t I> void finish_field()
+    {
+        static constexpr auto fields = T::json_ext_fields();
+        const auto &field = std::get<I>(fields);
+
+        if (!seen_.test(I))
+        {
+            if constexpr (std::remove_reference_t<decltype(field)>::has_default)
+            {
+                // there is no T of the row, the default is evaluated on the prototype, which gets the members
+                // declared before this one from the row first, as get decodes them before the default
+                if (!prototype_)
+                    prototype_.emplace();
+                sync_prototype(std::make_index_sequence<I>{});
+                auto fallback = field.default_value(*prototype_);
+                if constexpr (field_column_element<T, I>::is_optional)
+                {
+                    present_.set(I, fallback.has_value());
+                    if (fallback)
+                        std::get<I>(target_.columns_).back() = *std::move(fallback);
+                }
+                else
+                    std::get<I>(target_.columns_).back() = std::move(fallback);
+            }
+            else
+                throw nlohmann::detail::out_of_range::create(
+                    403, nlohmann::detail::concat("key '", std::string(field.name), "' not found"), nullptr);
+        }
+
+        if constexpr (has_presence<T, I>())
+            target_.presence_[I].push_back(present_.test(I));
+    }
+
+    // @summary copies the members of the row which the prototype doesn't hold yet, they are all finished already
+    template <std::size_t... Is> void sync_prototype(std::index_sequence<Is...>)
+    {
+        static constexpr auto fields = T::json_ext_fields();
+        T &prototype = *prototype_;
+        ((Is < synced_ ? void()
+                       : target_.template get_member<Is>(target_.size_, prototype.*(std::get<Is>(fields).member))),
+         ...);
+        synced_ = sizeof...(Is);
+    }
+
+    columns<T> &target_;
+    std::optional<T> &prototype_;
+    // the number of leading members the prototype holds of this row
+    std::size_t synced_ = 0;
+    std::size_t current_ = npos;
+    std::bitset<field_count<T>()> seen_;
+    std::bitset<field_count<T>()> present_;
+    key_precedence<T> precedence_;
+};
+
+template <typename T> class sax_columns_frame : public sax_frame
+{
+  public:
+    explicit sax_columns_frame(columns<T> &target) : target_(target)
+    {
+    }
+
+    // an array which isn't finished means the decoding threw (in any row or in the syntax), the rows decoded so far
+    // are dropped and a half decoded row would leave columns of different lengths
+    ~sax_columns_frame() override
+    {
+        if (!finished_)
+            target_.clear();
+    }
+
+    std::unique_ptr<sax_frame> value(sax_event &event) override
+    {
+        if (event.type != sax_event::kind::start_object)
+            throw_not_an_object<T>(event.type_name());
+
+        return std::make_unique<sax_columns_row_frame<T>>(target_, prototype_);
+    }
+
+    bool end(bool) override
+    {
+        finished_ = true;
+        return true;
+    }
+
+  private:
+    columns<T> &target_;
+    // built by the first row which misses a member with a default, shared by the rows of one decode, each row only
+    // relies on the members it copied into it
+    std::optional<T> prototype_;
+    bool finished_ = false;
+};
+
+// @summary parse_into decodes straight into the columns, no T and no nlohmann::json is built for the rows
+template <typename T> struct sax_value<columns<T>>
+{
+    static std::unique_ptr<sax_frame> parse(columns<T> &target, sax_event &event)
+    {
+        target.clear();
+        if (event.type != sax_event::kind::start_array)
+            event.throw_type_error("array");
+
+        return std::make_unique<sax_columns_frame<T>>(target);
+    }
+};
+
+// @summary writes the rows as array of objects, the same output as for the std::vector<T> of the rows
+template <typename T> struct json_writer<columns<T>>
+{
+    template <typename Sink> static void write(Sink &sink, const columns<T> &value)
+    {
+        sink.put('[');
+        for (std::size_t i = 0; i < value.size(); ++i)
+        {
+            if (i != 0)
+                sink.put(',');
+            sink.put('{');
+            write_keys(sink, value, i, std::make_index_sequence<key_count<T>()>{});
+            sink.put('}');
+        }
+        sink.put(']');
+    }
+
+  private:
+    template <typename Sink, std::size_t... Is>
+    static void write_keys(Sink &sink, const columns<T> &value, std::size_t row, std::index_sequence<Is...>)
+    {
+        static constexpr auto order = sorted_key_order<T>();
+
+        ((Is == 0 ? void() : sink.put(','), write_key<order[Is]>(sink, value, row)), ...);
+    }
+
+    template <std::size_t I, typename Sink> static void write_key(Sink &sink, const columns<T> &value, std::size_t row)
+    {
+        if constexpr (I == field_count<T>())
+        {
+            sink.put(tag_json_key);
+            write_escaped(sink, T::json_ext_tag);
+        }
+        else
+        {
+            static constexpr auto fields = T::json_ext_fields();
+            using element_type = typename field_column_element<T, I>::type;
+            constexpr auto member = std::get<I>(fields).member;
+
+            // the key is already quoted and followed by a colon
+            sink.put(std::get<I>(fields).json_key);
+            if constexpr (field_column_element<T, I>::is_optional)
+            {
+                if (!value.template presence<member>().test(row))
+                {
+                    sink.put("null");
+                    return;
+                }
+            }
+            write_value(sink, static_cast<const element_type &>(value.template column<member>()[row]));
+        }
+    }
+};
+} // namespace detail
+} // namespace json_ext
+
 ////////////////////////////////////////////////////////////////////////////////
-/// SERIALIZATION std::variant
-template <typename T, typename... Ts>
-void variant_from_json(const nlohmann::json &j, std::variant<Ts...> &data, bool &has_parsed)
+/// BINARY FORMATS
+namespace json_ext
 {
-    if (has_parsed)
-        return;
+enum class binary_format
+{
+    msgpack,
+    cbor,
+};
 
-    try
+namespace detail
+{
+struct byte_sink
+{
+    std::vector<std::uint8_t> &out;
+
+    void put(std::uint8_t byte)
     {
-        data = j.get<T>();
-        has_parsed = true;
+        out.push_back(byte);
     }
-    catch (...)
+
+    void put(std::string_view bytes)
+    {
+        out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+
+    // both formats store numbers in big endian
+    template <typename Number> void put_number(Number value)
+    {
+        std::array<std::uint8_t, sizeof(Number)> bytes{};
+        std::memcpy(bytes.data(), &value, sizeof(Number));
+        if (is_little_endian())
+            std::reverse(bytes.begin(), bytes.end());
+        out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+
+  private:
+    static bool is_little_endian()
+    {
+        const std::uint16_t one = 1;
+        std::uint8_t first = 0;
+        std::memcpy(&first, &one, 1);
+        return first == 1;
+    }
+};
+
+// @summary the initial byte(s) of a CBOR item with the major type (already shifted) and its argument, the shortest
+// possible encoding as nlohmann::json::to_cbor writes it
+inline void write_cbor_head(byte_sink &sink, std::uint8_t major, std::uint64_t argument)
+{
+    if (argument <= 0x17)
+        sink.put(static_cast<std::uint8_t>(major + argument));
+    else if (argument <= std::numeric_limits<std::uint8_t>::max())
     {
-        // if we couldn't parse the variant we don't care, from outside we will just try
-        // the next one
+        sink.put(static_cast<std::uint8_t>(major + 0x18));
+        sink.put_number(static_cast<std::uint8_t>(argument));
+    }
+    else if (argument <= std::numeric_limits<std::uint16_t>::max())
+    {
+        sink.put(static_cast<std::uint8_t>(major + 0x19));
+        sink.put_number(static_cast<std::uint16_t>(argument));
+    }
+    else if (argument <= std::numeric_limits<std::uint32_t>::max())
+    {
+        sink.put(static_cast<std::uint8_t>(major + 0x1A));
+        sink.put_number(static_cast<std::uint32_t>(argument));
+    }
+    else
+    {
+        sink.put(static_cast<std::uint8_t>(major + 0x1B));
+        sink.put_number(argument);
     }
 }
 
-template <typename... Ts> struct nlohmann::adl_serializer<std::variant<Ts...>>
+// @summary the head of a msgpack string, array or map, fix is the prefix of the fix encoding which is used up to
+// fix_max elements, the others are the prefixes of the 8, 16 and 32 bit length (0 if the encoding doesn't exist)
+inline void write_msgpack_head(byte_sink &sink, std::size_t size, std::uint8_t fix, std::size_t fix_max,
+                               std::uint8_t prefix8, std::uint8_t prefix16, std::uint8_t prefix32)
+{
+    if (size <= fix_max)
+        sink.put(static_cast<std::uint8_t>(fix | size));
+    else if (prefix8 != 0 && size <= std::numeric_limits<std::uint8_t>::max())
+    {
+        sink.put(prefix8);
+        sink.put_number(static_cast<std::uint8_t>(size));
+    }
+    else if (size <= std::numeric_limits<std::uint16_t>::max())
+    {
+        sink.put(prefix16);
+        sink.put_number(static_cast<std::uint16_t>(size));
+    }
+    else
+    {
+        sink.put(prefix32);
+        sink.put_number(static_cast<std::uint32_t>(size));
+    }
+}
+
+template <binary_format Format> void write_binary_null(byte_sink &sink)
 {
-    static void to_json(nlohmann::json &j, const std::variant<Ts...> &data)
+    sink.put(Format == binary_format::msgpack ? 0xC0 : 0xF6);
+}
+
+template <binary_format Format> void write_binary_unsigned(byte_sink &sink, std::uint64_t value)
+{
+    if constexpr (Format == binary_format::cbor)
+        write_cbor_head(sink, 0x00, value);
+    else if (value < 128)
+        sink.put(static_cast<std::uint8_t>(value));
+    else if (value <= std::numeric_limits<std::uint8_t>::max())
+    {
+        sink.put(0xCC);
+        sink.put_number(static_cast<std::uint8_t>(value));
+    }
+    else if (value <= std::numeric_limits<std::uint16_t>::max())
+    {
+        sink.put(0xCD);
+        sink.put_number(static_cast<std::uint16_t>(value));
+    }
+    else if (value <= std::numeric_limits<std::uint32_t>::max())
+    {
+        sink.put(0xCE);
+        sink.put_number(static_cast<std::uint32_t>(value));
+    }
+    else
     {
-        std::visit([&j](const auto &&unpacked) { j = unpacked; }, data);
+        sink.put(0xCF);
+        sink.put_number(value);
     }
+}
 
-    static void from_json(const nlohmann::json &j, std::variant<Ts...> &data)
+template <binary_format Format> void write_binary_signed(byte_sink &sink, std::int64_t value)
+{
+    // both formats don't differentiate between positive signed and unsigned integers
+    if (value >= 0)
+        write_binary_unsigned<Format>(sink, static_cast<std::uint64_t>(value));
+    else if constexpr (Format == binary_format::cbor)
+        write_cbor_head(sink, 0x20, static_cast<std::uint64_t>(-1 - value));
+    else if (value >= -32)
+        sink.put_number(static_cast<std::int8_t>(value));
+    else if (value >= std::numeric_limits<std::int8_t>::min())
     {
-        bool has_parsed = false;
-        (variant_from_json<Ts>(j, data, has_parsed), ...);
-        if (!has_parsed)
-            throw nlohmann::detail::other_error::create(
-                601, nlohmann::detail::concat("unable to find matching variant for: ", j.dump()), &j);
+        sink.put(0xD0);
+        sink.put_number(static_cast<std::int8_t>(value));
+    }
+    else if (value >= std::numeric_limits<std::int16_t>::min())
+    {
+        sink.put(0xD1);
+        sink.put_number(static_cast<std::int16_t>(value));
+    }
+    else if (value >= std::numeric_limits<std::int32_t>::min())
+    {
+        sink.put(0xD2);
+        sink.put_number(static_cast<std::int32_t>(value));
+    }
+    else
+    {
+        sink.put(0xD3);
+        sink.put_number(value);
+    }
+}
+
+template <binary_format Format> void write_binary_float(byte_sink &sink, double value)
+{
+    constexpr bool is_cbor = Format == binary_format::cbor;
+    if (is_cbor && std::isnan(value))
+    {
+        // half precision NaN
+        sink.put(0xF9);
+        sink.put(0x7E);
+        sink.put(0x00);
+    }
+    else if (is_cbor && std::isinf(value))
+    {
+        // half precision (-)infinity
+        sink.put(0xF9);
+        sink.put(value > 0 ? 0x7C : 0xFC);
+        sink.put(0x00);
+    }
+    // written as float if it doesn't lose precision, same as nlohmann::json
+    else if (value >= static_cast<double>(std::numeric_limits<float>::lowest()) &&
+             value <= static_cast<double>(std::numeric_limits<float>::max()) &&
+             static_cast<double>(static_cast<float>(value)) == value)
+    {
+        sink.put(is_cbor ? 0xFA : 0xCA);
+        sink.put_number(static_cast<float>(value));
+    }
+    else
+    {
+        sink.put(is_cbor ? 0xFB : 0xCB);
+        sink.put_number(value);
+    }
+}
+
+template <binary_format Format> void write_binary_string(byte_sink &sink, std::string_view value)
+{
+    if constexpr (Format == binary_format::cbor)
+        write_cbor_head(sink, 0x60, value.size());
+    else
+        write_msgpack_head(sink, value.size(), 0xA0, 31, 0xD9, 0xDA, 0xDB);
+    sink.put(value);
+}
+
+template <binary_format Format> void write_binary_array_head(byte_sink &sink, std::size_t size)
+{
+    if constexpr (Format == binary_format::cbor)
+        write_cbor_head(sink, 0x80, size);
+    else
+        write_msgpack_head(sink, size, 0x90, 15, 0, 0xDC, 0xDD);
+}
+
+template <binary_format Format> void write_binary_map_head(byte_sink &sink, std::size_t size)
+{
+    if constexpr (Format == binary_format::cbor)
+        write_cbor_head(sink, 0xA0, size);
+    else
+        write_msgpack_head(sink, size, 0x80, 15, 0, 0xDE, 0xDF);
+}
+
+// @summary describes how a T is encoded, the default converts the value to a json and encodes it with nlohmann::json,
+// so every type which works with to_json works here too
+template <typename T, typename = void> struct binary_writer
+{
+    template <binary_format Format> static void write(byte_sink &sink, const T &value)
+    {
+        if constexpr (Format == binary_format::cbor)
+            nlohmann::json::to_cbor(nlohmann::json(value), sink.out);
+        else
+            nlohmann::json::to_msgpack(nlohmann::json(value), sink.out);
     }
 };
 
-////////////////////////////////////////////////////////////////////////////////
-/// SERIALIZATION std::optional
-template <typename T> struct nlohmann::adl_serializer<std::optional<T>>
+template <binary_format Format, typename T> void write_binary_value(byte_sink &sink, const T &value)
 {
-    static void to_json(nlohmann::json &j, const std::optional<T> &data)
+    binary_writer<T>::template write<Format>(sink, value);
+}
+
+template <> struct binary_writer<bool>
+{
+    template <binary_format Format> static void write(byte_sink &sink, bool value)
     {
-        if (data)
-            j = *data;
+        if constexpr (Format == binary_format::cbor)
+            sink.put(value ? 0xF5 : 0xF4);
+        else
+            sink.put(value ? 0xC3 : 0xC2);
+    }
+};
+
+template <typename T> struct binary_writer<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+{
+    template <binary_format Format> static void write(byte_sink &sink, T value)
+    {
+        if constexpr (std::is_signed_v<T>)
+            write_binary_signed<Format>(sink, value);
+        else
+            write_binary_unsigned<Format>(sink, value);
+    }
+};
+
+template <typename T> struct binary_writer<T, std::enable_if_t<std::is_floating_point_v<T>>>
+{
+    template <binary_format Format> static void write(byte_sink &sink, T value)
+    {
+        write_binary_float<Format>(sink, static_cast<nlohmann::json::number_float_t>(value));
+    }
+};
+
+template <> struct binary_writer<std::string>
+{
+    template <binary_format Format> static void write(byte_sink &sink, const std::string &value)
+    {
+        write_binary_string<Format>(sink, value);
+    }
+};
+
+template <> struct binary_writer<std::string_view>
+{
+    template <binary_format Format> static void write(byte_sink &sink, std::string_view value)
+    {
+        write_binary_string<Format>(sink, value);
+    }
+};
+
+template <typename T> struct binary_writer<T, std::enable_if_t<is_reflected_enum<T>::value>>
+{
+    template <binary_format Format> static void write(byte_sink &sink, T value)
+    {
+        if constexpr (enum_table<T>::reflection.as_integer)
+            write_binary_unsigned<Format>(sink, enumerator_index(value));
+        else
+            write_binary_string<Format>(sink, enumerator_name(value));
+    }
+};
+
+template <typename T> struct binary_writer<std::optional<T>>
+{
+    template <binary_format Format> static void write(byte_sink &sink, const std::optional<T> &value)
+    {
+        if (value)
+            write_binary_value<Format>(sink, *value);
+        else
+            write_binary_null<Format>(sink);
+    }
+};
+
+template <typename... Ts> struct binary_writer<std::variant<Ts...>>
+{
+    template <binary_format Format> static void write(byte_sink &sink, const std::variant<Ts...> &value)
+    {
+        std::visit([&sink](const auto &unpacked) { write_binary_value<Format>(sink, unpacked); }, value);
+    }
+};
+
+template <typename T, typename Allocator> struct binary_writer<std::vector<T, Allocator>>
+{
+    template <binary_format Format> static void write(byte_sink &sink, const std::vector<T, Allocator> &value)
+    {
+        write_binary_array_head<Format>(sink, value.size());
+        for (const auto &element : value)
+            write_binary_value<Format>(sink, static_cast<const T &>(element));
+    }
+};
+
+// std::map<std::string, ...> is already sorted the same way as the objects of nlohmann::json
+template <typename T, typename Compare, typename Allocator>
+struct binary_writer<std::map<std::string, T, Compare, Allocator>,
+                     std::enable_if_t<std::is_same_v<Compare, std::less<std::string>> ||
+                                      std::is_same_v<Compare, std::less<>>>>
+{
+    template <binary_format Format>
+    static void write(byte_sink &sink, const std::map<std::string, T, Compare, Allocator> &value)
+    {
+        write_binary_map_head<Format>(sink, value.size());
+        for (const auto &[key, element] : value)
+        {
+            write_binary_string<Format>(sink, key);
+            write_binary_value<Format>(sink, element);
+        }
+    }
+};
+
+template <typename T> struct binary_writer<T, std::enable_if_t<is_reflected<T>::value>>
+{
+    template <binary_format Format> static void write(byte_sink &sink, const T &value)
+    {
+        write_binary_map_head<Format>(sink, key_count<T>());
+        write_keys<Format>(sink, value, std::make_index_sequence<key_count<T>()>{});
+    }
+
+  private:
+    template <binary_format Format, std::size_t... Is>
+    static void write_keys(byte_sink &sink, const T &value, std::index_sequence<Is...>)
+    {
+        // the same order as the json writer, the keys of a nlohmann::json object are sorted
+        static constexpr auto order = sorted_key_order<T>();
+
+        (write_key<Format, order[Is]>(sink, value), ...);
     }
 
-    static void from_json(const nlohmann::json &j, std::optional<T> &data)
+    template <binary_format Format, std::size_t I> static void write_key(byte_sink &sink, const T &value)
     {
-        if (!j.is_null())
-            data = j.get<T>();
+        if constexpr (I == field_count<T>())
+        {
+            write_binary_string<Format>(sink, tag_key);
+            write_binary_string<Format>(sink, T::json_ext_tag);
+        }
+        else
+        {
+            static constexpr auto fields = T::json_ext_fields();
+            write_binary_string<Format>(sink, std::get<I>(fields).name);
+            write_binary_value<Format>(sink, value.*(std::get<I>(fields).member));
+        }
     }
 };
 
+template <binary_format Format> constexpr nlohmann::json::input_format_t input_format()
+{
+    return Format == binary_format::cbor ? nlohmann::json::input_format_t::cbor
+                                         : nlohmann::json::input_format_t::msgpack;
+}
+} // namespace detail
+
+// @summary encodes value without building a nlohmann::json, the bytes are the same as nlohmann::json::to_msgpack /
+// to_cbor of nlohmann::json(value), appends to out
+template <binary_format Format, typename T> void write_binary(const T &value, std::vector<std::uint8_t> &out)
+{
+    detail::byte_sink sink{out};
+    detail::write_binary_value<Format>(sink, value);
+}
+
+template <typename T> std::vector<std::uint8_t> to_msgpack(const T &value)
+{
+    std::vector<std::uint8_t> out;
+    write_binary<binary_format::msgpack>(value, out);
+    return out;
+}
+
+template <typename T> std::vector<std::uint8_t> to_cbor(const T &value)
+{
+    std::vector<std::uint8_t> out;
+    write_binary<binary_format::cbor>(value, out);
+    return out;
+}
+
+// @summary decodes msgpack / cbor directly into a T with the SAX decoder of parse_into, accepts and rejects the same
+// input as nlohmann::json::from_msgpack / from_cbor followed by get<T>(). input is everything nlohmann::json accepts
+// as input, e.g. a std::vector<std::uint8_t>
+template <binary_format Format, typename T, typename InputType> void read_binary(InputType &&input, T &value)
+{
+    detail::sax_decoder<T> decoder(value);
+    nlohmann::json::sax_parse(std::forward<InputType>(input), &decoder, detail::input_format<Format>());
+}
+
+template <typename T, typename InputType> T from_msgpack(InputType &&input)
+{
+    T value;
+    read_binary<binary_format::msgpack>(std::forward<InputType>(input), value);
+    return value;
+}
+
+template <typename T, typename InputType> T from_cbor(InputType &&input)
+{
+    T value;
+    read_binary<binary_format::cbor>(std::forward<InputType>(input), value);
+    return value;
+}
+} // namespace json_ext
+
 ////////////////////////////////////////////////////////////////////////////////
 /// PLACEHOLDER TO ADAPT ARRAY OF TUPLE
 /// (https://stackoverflow.com/questions/24309309/how-to-use-boost-preprocessor-to-generate-accessors)
@@ -107,6 +5354,16 @@ template <typename T> struct nlohmann::adl_serializer<std::optional<T>>
 #define GET_VARIABLE_VALUE(var_type_and_name_and_maybe_value)                                                          \
     _GET_VARIABLE_VALUE(BOOST_PP_TUPLE_ELEM(3, 2, var_type_and_name_and_maybe_value))
 
+#define _GET_VARIABLE_ALIAS(var_type, var_name, var_value, alias, ...) alias
+#define _GET_VARIABLE_ALIAS_PAD(...) (__VA_ARGS__, , )
+#define _GET_VARIABLE_ALIAS_EXPAND(...) __VA_ARGS__
+
+// @summary input (variable_type, variable_name, optional(variable_default_value), optional("alias")) will extract
+// tuple[3] aka the alias, empty if the tuple has less elements. A required member with alias is declared with an empty
+// default value: (variable_type, variable_name, , "alias")
+#define GET_VARIABLE_ALIAS(var_type_and_name_and_maybe_value)                                                          \
+    _GET_VARIABLE_ALIAS_EXPAND(_GET_VARIABLE_ALIAS _GET_VARIABLE_ALIAS_PAD var_type_and_name_and_maybe_value)
+
 #define DEFINE_VARIABLE(R, data, var_type_and_name_and_maybe_value)                                                    \
     GET_VARIABLE_TYPE(var_type_and_name_and_maybe_value)                                                               \
     GET_VARIABLE_NAME(var_type_and_name_and_maybe_value) GET_VARIABLE_VALUE(var_type_and_name_and_maybe_value);
@@ -115,65 +5372,99 @@ template <typename T> struct nlohmann::adl_serializer<std::optional<T>>
     BOOST_PP_SEQ_FOR_EACH(DEFINE_VARIABLE, _,                                                                          \
                           BOOST_PP_CAT(CREATE_PLACEHOLDER_FILLER_0 var_types_and_names_and_maybe_values, _END))
 
+// without default nothing is generated
+#define DEFINE_DEFAULT_1(var_type, var_name, ...)
+
+// with default a member function returns the declared default value, it is evaluated in the context of the object, so
+// the default may refer to the members declared before it as their member initializer does: (int, a, 1)(int, b, a + 1)
+// defaults b to the decoded a plus one. Every decoding path decodes the members declared before a missing member first,
+// a default which refers to a member declared after it is unspecified. No default object is built, and the expression
+// is evaluated anew for every missing member
+#define DEFINE_DEFAULT_0(var_type, var_name, ...)                                                                      \
+    var_type BOOST_PP_CAT(json_ext_default_, var_name)() const                                                         \
+    {                                                                                                                  \
+        return __VA_ARGS__;                                                                                            \
+    }
+
+#define DEFINE_DEFAULT(R, data, var_type_and_name_and_maybe_value)                                                     \
+    BOOST_PP_CAT(DEFINE_DEFAULT_, BOOST_PP_IS_EMPTY(BOOST_PP_TUPLE_ELEM(3, 2, var_type_and_name_and_maybe_value)))     \
+    (GET_VARIABLE_TYPE(var_type_and_name_and_maybe_value), GET_VARIABLE_NAME(var_type_and_name_and_maybe_value),       \
+     BOOST_PP_TUPLE_ELEM(3, 2, var_type_and_name_and_maybe_value))
+
+// the default functions are private, only the generated from_json and json_ext_fields call them. The macro is used in a
+// public section anyway (json_ext uses json_ext_fields), so the section is public again afterwards
+#define DEFINE_DEFAULTS(var_types_and_names_and_maybe_values)                                                          \
+  private:                                                                                                             \
+    BOOST_PP_SEQ_FOR_EACH(DEFINE_DEFAULT, _,                                                                           \
+                          BOOST_PP_CAT(CREATE_PLACEHOLDER_FILLER_0 var_types_and_names_and_maybe_values, _END))        \
+                                                                                                                       \
+  public:
+
 ////////////////////////////////////////////////////////////////////////////////
 /// NLOHMANN SERIALIZATION DEFINITION FROM
 
-// defines without default
-#define DEFINE_JSON_FROM_WITHOUT_DEFAULT_1(var_name) NLOHMANN_JSON_FROM(var_name);
+// defines without default, the same as NLOHMANN_JSON_FROM, but moves out of an rvalue json
+#define DEFINE_JSON_FROM_WITHOUT_DEFAULT_1(Type, var_name, alias, ...)                                                 \
+    json_ext::detail::get_required(nlohmann_json_j, BOOST_PP_STRINGIZE(var_name), std::string_view(alias),             \
+                                   nlohmann_json_t.var_name);
 
-// defined with default
-#define DEFINE_JSON_FROM_WITHOUT_DEFAULT_0(var_name) NLOHMANN_JSON_FROM_WITH_DEFAULT(var_name)
+// defined with default, the default value is only evaluated if the key is missing, see DEFINE_DEFAULT
+#define DEFINE_JSON_FROM_WITHOUT_DEFAULT_0(Type, var_name, alias, ...)                                                 \
+    if (!json_ext::detail::get_if_present(nlohmann_json_j, BOOST_PP_STRINGIZE(var_name), std::string_view(alias),      \
+                                          nlohmann_json_t.var_name))                                                   \
+        nlohmann_json_t.var_name = nlohmann_json_t.BOOST_PP_CAT(json_ext_default_, var_name)();
 #define DEFINE_JSON_FROM_WITHOUT_DEFAULT_ DEFINE_JSON_FROM_WITHOUT_DEFAULT_
 
 #define __DEFINE_FROM_JSON(...) BOOST_PP_CAT(DEFINE_JSON_FROM_WITHOUT_DEFAULT_, BOOST_PP_IS_EMPTY(__VA_ARGS__))
 
-#define _DEFINE_FROM_JSON(R, data, var_type_and_name_and_maybe_value)                                                  \
+#define _DEFINE_FROM_JSON(R, Type, var_type_and_name_and_maybe_value)                                                  \
     __DEFINE_FROM_JSON(BOOST_PP_TUPLE_ELEM(3, 2, var_type_and_name_and_maybe_value))                                   \
-    (GET_VARIABLE_NAME(var_type_and_name_and_maybe_value))
+    (Type, GET_VARIABLE_NAME(var_type_and_name_and_maybe_value),                                                       \
+     GET_VARIABLE_ALIAS(var_type_and_name_and_maybe_value),                                                            \
+     BOOST_PP_TUPLE_ELEM(3, 2, var_type_and_name_and_maybe_value))
 
-#define DEFINE_FROM_JSON(Type, var_types_and_names_and_maybe_values)                                                   \
-    friend void from_json(const nlohmann::json &nlohmann_json_j, Type &nlohmann_json_t)                                \
+#define DEFINE_FROM_JSON_BODY(Type, var_types_and_names_and_maybe_values)                                              \
     {                                                                                                                  \
-        const Type nlohmann_json_default_obj{};                                                                        \
-        BOOST_PP_SEQ_FOR_EACH(_DEFINE_FROM_JSON, _,                                                                    \
+        JSON_EXT_DECODE_SCOPE(Type);                                                                                   \
+        /* checks the tag of types defined with NLOHMANN_SERIALIZE_TAGGED, does nothing for all other types */         \
+        json_ext::detail::from_json_tag<Type>(nlohmann_json_j);                                                        \
+        BOOST_PP_SEQ_FOR_EACH(_DEFINE_FROM_JSON, Type,                                                                 \
                               BOOST_PP_CAT(CREATE_PLACEHOLDER_FILLER_0 var_types_and_names_and_maybe_values, _END))    \
     }
 
-#define __DEFINE_POSSIBLE_KEYS(var_type_and_name_and_maybe_value)                                                      \
-    BOOST_PP_STRINGIZE(GET_VARIABLE_NAME(var_type_and_name_and_maybe_value)),
+// the keys are checked against the reflected keys of the class and the members are decoded in one pass over the json,
+// see json_ext::detail::from_json_strict
+#define DEFINE_FROM_JSON_STRICT_BODY(Type, var_types_and_names_and_maybe_values)                                       \
+    {                                                                                                                  \
+        JSON_EXT_DECODE_SCOPE(Type);                                                                                   \
+        json_ext::detail::from_json_strict(nlohmann_json_j, nlohmann_json_t);                                          \
+    }
 
-#define _DEFINE_POSSIBLE_KEYS(R, data, var_type_and_name_and_maybe_value)                                              \
-    __DEFINE_POSSIBLE_KEYS(var_type_and_name_and_maybe_value)
+#define DEFINE_FROM_JSON(Type, var_types_and_names_and_maybe_values)                                                   \
+    template <typename BasicJsonType,                                                                                  \
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>                        \
+    friend void from_json(const BasicJsonType &nlohmann_json_j, Type &nlohmann_json_t)                                 \
+    DEFINE_FROM_JSON_BODY(Type, var_types_and_names_and_maybe_values)                                                  \
+                                                                                                                       \
+    /* the same for an rvalue json, its strings and arrays are moved into the members, see json_ext::get */            \
+    /* an lvalue json deduces BasicJsonType as a reference, which is no basic_json, so it takes the overload above */  \
+    template <typename BasicJsonType,                                                                                  \
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>                        \
+    friend void from_json(BasicJsonType &&nlohmann_json_j, Type &nlohmann_json_t)                                      \
+    DEFINE_FROM_JSON_BODY(Type, var_types_and_names_and_maybe_values)
 
 #define DEFINE_FROM_JSON_STRICT(Type, var_types_and_names_and_maybe_values)                                            \
-    friend void from_json(const nlohmann::json &nlohmann_json_j, Type &nlohmann_json_t)                                \
-    {                                                                                                                  \
-        /* strict serialization stores the possible keys in the function, to check if additional keys are present */   \
-        static const std::vector<std::string> possible_keys = {BOOST_PP_SEQ_FOR_EACH(                                  \
-            _DEFINE_POSSIBLE_KEYS, _,                                                                                  \
-            BOOST_PP_CAT(CREATE_PLACEHOLDER_FILLER_0 var_types_and_names_and_maybe_values, _END))};                    \
-                                                                                                                       \
-        /* check that every key in our json, exists in the reflected keys of our serialized class */                   \
-        for (const auto &item : nlohmann_json_j.items())                                                               \
-        {                                                                                                              \
-            bool is_allowed_key =                                                                                      \
-                std::find(possible_keys.begin(), possible_keys.end(), item.key()) != possible_keys.end();              \
-            /* if an additional aka. non-allowed key is found kill the serialization */                                \
-            if (!is_allowed_key)                                                                                       \
-            {                                                                                                          \
-                throw nlohmann::detail::other_error::create(                                                           \
-                    600,                                                                                               \
-                    nlohmann::detail::concat("key '", item.key(),                                                      \
-                                             "' not present in reflected keys: ", nlohmann_json_j.dump()),             \
-                    &nlohmann_json_j);                                                                                 \
-            }                                                                                                          \
-        }                                                                                                              \
+    template <typename BasicJsonType,                                                                                  \
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>                        \
+    friend void from_json(const BasicJsonType &nlohmann_json_j, Type &nlohmann_json_t)                                 \
+    DEFINE_FROM_JSON_STRICT_BODY(Type, var_types_and_names_and_maybe_values)                                           \
                                                                                                                        \
-        const Type nlohmann_json_default_obj{};                                                                        \
-        /* define the parsing as in the non-strict version */                                                          \
-        BOOST_PP_SEQ_FOR_EACH(_DEFINE_FROM_JSON, _,                                                                    \
-                              BOOST_PP_CAT(CREATE_PLACEHOLDER_FILLER_0 var_types_and_names_and_maybe_values, _END))    \
-    }
+    /* the same for an rvalue json, its strings and arrays are moved into the members, see json_ext::get */            \
+    /* an lvalue json deduces BasicJsonType as a reference, which is no basic_json, so it takes the overload above */  \
+    template <typename BasicJsonType,                                                                                  \
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>                        \
+    friend void from_json(BasicJsonType &&nlohmann_json_j, Type &nlohmann_json_t)                                      \
+    DEFINE_FROM_JSON_STRICT_BODY(Type, var_types_and_names_and_maybe_values)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// NLOHMANN SERIALIZATION DEFINITION TO
@@ -183,20 +5474,136 @@ template <typename T> struct nlohmann::adl_serializer<std::optional<T>>
     __DEFINE_TO_JSON(GET_VARIABLE_NAME(var_type_and_name_and_maybe_value))
 
 #define DEFINE_TO_JSON(Type, var_types_and_names_and_maybe_values)                                                     \
-    friend void to_json(nlohmann::json &nlohmann_json_j, const Type &nlohmann_json_t)                                  \
+    template <typename BasicJsonType,                                                                                  \
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>                        \
+    friend void to_json(BasicJsonType &nlohmann_json_j, const Type &nlohmann_json_t)                                   \
     {                                                                                                                  \
+        JSON_EXT_ENCODE_SCOPE(Type);                                                                                   \
         BOOST_PP_SEQ_FOR_EACH(_DEFINE_TO_JSON, _,                                                                      \
                               BOOST_PP_CAT(CREATE_PLACEHOLDER_FILLER_0 var_types_and_names_and_maybe_values, _END))    \
+        json_ext::detail::to_json_tag<Type>(nlohmann_json_j);                                                          \
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// REFLECTION DEFINITION
+
+// without default there is no value, the member is required anyway
+#define DEFINE_FIELD_DEFAULT_1(Type, var_name, ...)                                                                    \
+    [](const Type &) {}
+
+// with default the declared default value is evaluated by the member function DEFINE_DEFAULT generates
+#define DEFINE_FIELD_DEFAULT_0(Type, var_name, ...)                                                                    \
+    [](const Type &nlohmann_json_t) { return nlohmann_json_t.BOOST_PP_CAT(json_ext_default_, var_name)(); }
+
+#define __DEFINE_FIELD(Type, var_name, alias, ...)                                                                     \
+    json_ext::detail::make_field<BOOST_PP_NOT(BOOST_PP_IS_EMPTY(__VA_ARGS__))>(                                        \
+        BOOST_PP_STRINGIZE(var_name), "\"" BOOST_PP_STRINGIZE(var_name) "\":", std::string_view(alias),                \
+        "\"" alias "\":", &Type::var_name,                                                                             \
+        BOOST_PP_CAT(DEFINE_FIELD_DEFAULT_, BOOST_PP_IS_EMPTY(__VA_ARGS__))(Type, var_name, __VA_ARGS__))
+
+#define _DEFINE_FIELD(R, Type, I, var_type_and_name_and_maybe_value)                                                   \
+    BOOST_PP_COMMA_IF(I)                                                                                               \
+    __DEFINE_FIELD(Type, GET_VARIABLE_NAME(var_type_and_name_and_maybe_value),                                         \
+                   GET_VARIABLE_ALIAS(var_type_and_name_and_maybe_value),                                              \
+                   BOOST_PP_TUPLE_ELEM(3, 2, var_type_and_name_and_maybe_value))
+
+// @summary the value of the tag key (JSON_EXT_TAG_KEY) which identifies the type inside of a std::variant
+#define DEFINE_TAG(tag) static constexpr std::string_view json_ext_tag = tag;
+
+// @summary stores the reflected members as a tuple of json_ext::detail::field, this is what everything in json_ext
+// which isn't generated directly by the macros (e.g. the variant probing) works on
+#define DEFINE_REFLECTION(Type, is_strict, var_types_and_names_and_maybe_values)                                       \
+    static constexpr bool json_ext_strict = is_strict;                                                                 \
+    static constexpr auto json_ext_fields()                                                                            \
+    {                                                                                                                  \
+        return std::make_tuple(BOOST_PP_SEQ_FOR_EACH_I(                                                                \
+            _DEFINE_FIELD, Type, BOOST_PP_CAT(CREATE_PLACEHOLDER_FILLER_0 var_types_and_names_and_maybe_values, _END))); \
     }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// NEW SERIALIZATION INTERFACE
 #define NLOHMANN_SERIALIZE(Type, var_types_and_names_and_maybe_values)                                                 \
     DEFINE_VARIABLES(var_types_and_names_and_maybe_values)                                                             \
+    DEFINE_DEFAULTS(var_types_and_names_and_maybe_values)                                                              \
+    DEFINE_REFLECTION(Type, false, var_types_and_names_and_maybe_values)                                               \
     DEFINE_TO_JSON(Type, var_types_and_names_and_maybe_values)                                                         \
     DEFINE_FROM_JSON(Type, var_types_and_names_and_maybe_values)
 
 #define NLOHMANN_SERIALIZE_STRICT(Type, var_types_and_names_and_maybe_values)                                          \
     DEFINE_VARIABLES(var_types_and_names_and_maybe_values)                                                             \
+    DEFINE_DEFAULTS(var_types_and_names_and_maybe_values)                                                              \
+    DEFINE_REFLECTION(Type, true, var_types_and_names_and_maybe_values)                                                \
     DEFINE_TO_JSON(Type, var_types_and_names_and_maybe_values)                                                         \
     DEFINE_FROM_JSON_STRICT(Type, var_types_and_names_and_maybe_values)
+
+// @summary the same as NLOHMANN_SERIALIZE, but the json also contains the key JSON_EXT_TAG_KEY with the value tag, a
+// std::variant of only tagged types selects the alternative by the tag without trying the others
+#define NLOHMANN_SERIALIZE_TAGGED(Type, tag, var_types_and_names_and_maybe_values)                                     \
+    DEFINE_TAG(tag)                                                                                                    \
+    NLOHMANN_SERIALIZE(Type, var_types_and_names_and_maybe_values)
+
+#define NLOHMANN_SERIALIZE_STRICT_TAGGED(Type, tag, var_types_and_names_and_maybe_values)                              \
+    DEFINE_TAG(tag)                                                                                                    \
+    NLOHMANN_SERIALIZE_STRICT(Type, var_types_and_names_and_maybe_values)
+
+////////////////////////////////////////////////////////////////////////////////
+/// ENUM DEFINITION
+
+// @summary input (enumerator, optional("json name")) will extract tuple[0] aka the enumerator
+#define GET_ENUMERATOR(enumerator_and_maybe_name) BOOST_PP_TUPLE_ELEM(2, 0, enumerator_and_maybe_name)
+
+// without a json name the enumerator is written as it is called
+#define GET_ENUMERATOR_NAME_1(enumerator, ...) BOOST_PP_STRINGIZE(enumerator)
+#define GET_ENUMERATOR_NAME_0(enumerator, ...) __VA_ARGS__
+
+#define GET_ENUMERATOR_NAME(enumerator_and_maybe_name)                                                                 \
+    BOOST_PP_CAT(GET_ENUMERATOR_NAME_, BOOST_PP_IS_EMPTY(BOOST_PP_TUPLE_ELEM(2, 1, enumerator_and_maybe_name)))        \
+    (GET_ENUMERATOR(enumerator_and_maybe_name), BOOST_PP_TUPLE_ELEM(2, 1, enumerator_and_maybe_name))
+
+#define DEFINE_ENUMERATOR(R, data, I, enumerator_and_maybe_name)                                                       \
+    BOOST_PP_COMMA_IF(I) GET_ENUMERATOR(enumerator_and_maybe_name)
+
+#define DEFINE_ENUMERATOR_NAME(R, data, I, enumerator_and_maybe_name)                                                  \
+    BOOST_PP_COMMA_IF(I) std::string_view(GET_ENUMERATOR_NAME(enumerator_and_maybe_name))
+
+// @summary declares the enum class with the enumerators in the given order and json_ext_enum, which returns the names
+// as json_ext::detail::enum_reflection, the to_json / from_json are more specialized than the ones nlohmann::json
+// defines for every enum
+#define DEFINE_ENUM(Type, as_integer, enumerators_and_maybe_names)                                                     \
+    enum class Type                                                                                                    \
+    {                                                                                                                  \
+        BOOST_PP_SEQ_FOR_EACH_I(DEFINE_ENUMERATOR, _,                                                                  \
+                                BOOST_PP_CAT(CREATE_PLACEHOLDER_FILLER_0 enumerators_and_maybe_names, _END))           \
+    };                                                                                                                 \
+                                                                                                                       \
+    constexpr auto json_ext_enum(Type)                                                                                 \
+    {                                                                                                                  \
+        return json_ext::detail::make_enum_reflection(                                                                 \
+            BOOST_PP_STRINGIZE(Type), as_integer,                                                                      \
+            std::array{BOOST_PP_SEQ_FOR_EACH_I(DEFINE_ENUMERATOR_NAME, _,                                              \
+                                               BOOST_PP_CAT(CREATE_PLACEHOLDER_FILLER_0 enumerators_and_maybe_names,   \
+                                                            _END))});                                                  \
+    }                                                                                                                  \
+                                                                                                                       \
+    template <typename BasicJsonType,                                                                                  \
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>                        \
+    void to_json(BasicJsonType &nlohmann_json_j, Type nlohmann_json_t)                                                 \
+    {                                                                                                                  \
+        json_ext::detail::enum_to_json(nlohmann_json_j, nlohmann_json_t);                                              \
+    }                                                                                                                  \
+                                                                                                                       \
+    template <typename BasicJsonType,                                                                                  \
+              std::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>                        \
+    void from_json(const BasicJsonType &nlohmann_json_j, Type &nlohmann_json_t)                                        \
+    {                                                                                                                  \
+        json_ext::detail::enum_from_json(nlohmann_json_j, nlohmann_json_t);                                            \
+    }
+
+// @summary declares enum class Type with its json names at namespace scope, e.g.
+// NLOHMANN_SERIALIZE_ENUM(Color, (red)(dark_blue, "dark-blue")), the enumerators are written as their names
+#define NLOHMANN_SERIALIZE_ENUM(Type, enumerators_and_maybe_names)                                                     \
+    DEFINE_ENUM(Type, false, enumerators_and_maybe_names)
+
+// @summary the same as NLOHMANN_SERIALIZE_ENUM, but the enumerators are written as their values 0, 1, ...
+#define NLOHMANN_SERIALIZE_ENUM_AS_INTEGER(Type, enumerators_and_maybe_names)                                          \
+    DEFINE_ENUM(Type, true, enumerators_and_maybe_names)
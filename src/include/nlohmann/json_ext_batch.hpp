@@ -0,0 +1,374 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+/// MAPPED FILES
+namespace json_ext
+{
+// @summary a read only memory mapping of a whole file, the records of a batch are views into the mapping
+class mapped_file
+{
+  public:
+    explicit mapped_file(const std::string &path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "unable to open " + path);
+
+        struct stat info
+        {
+        };
+        if (::fstat(fd, &info) != 0)
+        {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "unable to stat " + path);
+        }
+
+        size_ = static_cast<std::size_t>(info.st_size);
+        // mapping an empty file fails, an empty view is all we need
+        if (size_ != 0)
+        {
+            data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data_ == MAP_FAILED)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "unable to map " + path);
+            }
+            // the records are read once from front to back
+            ::madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    ~mapped_file()
+    {
+        if (data_ != nullptr)
+            ::munmap(data_, size_);
+    }
+
+    std::string_view view() const noexcept
+    {
+        return {static_cast<const char *>(data_), size_};
+    }
+
+  private:
+    void *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// RECORD SPLITTING
+namespace json_ext
+{
+enum class batch_format
+{
+    // one json array, every element is a record
+    array,
+    // newline delimited json, every non-empty line is a record
+    ndjson,
+};
+
+namespace detail
+{
+constexpr bool is_json_whitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline std::string_view trim_whitespace(std::string_view record)
+{
+    while (!record.empty() && is_json_whitespace(record.front()))
+        record.remove_prefix(1);
+    while (!record.empty() && is_json_whitespace(record.back()))
+        record.remove_suffix(1);
+    return record;
+}
+
+// @summary position is the index of the failing byte, the error reports it 1-based as nlohmann::json and lazy_view do
+[[noreturn]] inline void throw_split_error(std::size_t position, const std::string &message)
+{
+    throw nlohmann::detail::parse_error::create(
+        101, position + 1, nlohmann::detail::concat("syntax error while splitting records: ", message), nullptr);
+}
+
+inline std::vector<std::string_view> split_ndjson(std::string_view input)
+{
+    std::vector<std::string_view> records;
+    std::size_t begin = 0;
+    while (begin < input.size())
+    {
+        auto end = input.find('\n', begin);
+        if (end == std::string_view::npos)
+            end = input.size();
+
+        const auto line = trim_whitespace(input.substr(begin, end - begin));
+        if (!line.empty())
+            records.push_back(line);
+        begin = end + 1;
+    }
+    return records;
+}
+
+// @summary splits the elements of a json array at the commas on the top level, only strings and nesting are tracked,
+// everything else is validated when the record is decoded. An empty element (e.g. [1,] or [,]) is no json at all and
+// rejects the whole input
+inline std::vector<std::string_view> split_array(std::string_view input)
+{
+    std::size_t pos = 0;
+    const auto skip_whitespace = [&] {
+        while (pos < input.size() && is_json_whitespace(input[pos]))
+            ++pos;
+    };
+
+    skip_whitespace();
+    if (pos == input.size() || input[pos] != '[')
+        throw_split_error(pos, "expected '['");
+    ++pos;
+
+    std::vector<std::string_view> records;
+    const auto push_record = [&](std::size_t begin, std::size_t end) {
+        const auto record = trim_whitespace(input.substr(begin, end - begin));
+        if (record.empty())
+            throw_split_error(end, nlohmann::detail::concat("unexpected '", std::string(1, input[end]), "'"));
+        records.push_back(record);
+    };
+
+    skip_whitespace();
+    if (pos < input.size() && input[pos] == ']')
+        ++pos;
+    else
+    {
+        std::size_t begin = pos;
+        std::size_t depth = 0;
+        bool in_string = false;
+        bool closed = false;
+        for (; pos < input.size() && !closed; ++pos)
+        {
+            const char c = input[pos];
+            if (in_string)
+            {
+                if (c == '\\')
+                    ++pos;
+                else if (c == '"')
+                    in_string = false;
+                continue;
+            }
+
+            switch (c)
+            {
+            case '"':
+                in_string = true;
+                break;
+            case '[':
+            case '{':
+                ++depth;
+                break;
+            case '}':
+            case ']':
+                if (depth == 0)
+                {
+                    if (c == '}')
+                        throw_split_error(pos, "unexpected '}'");
+                    push_record(begin, pos);
+                    closed = true;
+                }
+                else
+                    --depth;
+                break;
+            case ',':
+                if (depth == 0)
+                {
+                    push_record(begin, pos);
+                    begin = pos + 1;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (!closed)
+            throw_split_error(input.size(), "unexpected end of input, expected ']'");
+    }
+
+    skip_whitespace();
+    if (pos != input.size())
+        throw_split_error(pos, "unexpected content after ']'");
+    return records;
+}
+
+inline std::vector<std::string_view> split_records(std::string_view input, batch_format format)
+{
+    return format == batch_format::array ? split_array(input) : split_ndjson(input);
+}
+} // namespace detail
+} // namespace json_ext
+
+////////////////////////////////////////////////////////////////////////////////
+/// BATCH DECODING
+namespace json_ext
+{
+struct batch_options
+{
+    // 0 uses std::thread::hardware_concurrency()
+    std::size_t threads = 0;
+    // the number of records a worker takes at once
+    std::size_t chunk_size = 256;
+};
+
+struct batch_error
+{
+    // the index of the record in the batch, the value at this index is left default constructed
+    std::size_t index;
+    // the byte offset of the record in the input
+    std::size_t offset;
+    std::string message;
+};
+
+template <typename T> struct batch_result
+{
+    // in input order, one value per record
+    std::vector<T> values;
+    // sorted by index
+    std::vector<batch_error> errors;
+};
+
+namespace detail
+{
+// @summary joins the started threads when it goes out of scope, also if starting another thread threw: destroying a
+// joinable std::thread calls std::terminate
+class thread_joiner
+{
+  public:
+    explicit thread_joiner(std::vector<std::thread> &threads) noexcept : threads_(threads)
+    {
+    }
+
+    thread_joiner(const thread_joiner &) = delete;
+    thread_joiner &operator=(const thread_joiner &) = delete;
+
+    ~thread_joiner()
+    {
+        for (auto &thread : threads_)
+            if (thread.joinable())
+                thread.join();
+    }
+
+  private:
+    std::vector<std::thread> &threads_;
+};
+
+// @summary decodes the records into values, the workers take the next chunk of records from a shared counter until all
+// are taken, so fast workers simply take more chunks. Every record is decoded with parse_into, an error only affects
+// its own record
+template <typename T>
+std::vector<batch_error> decode_records(std::string_view input, const std::vector<std::string_view> &records,
+                                        std::vector<T> &values, const batch_options &options)
+{
+    const std::size_t chunk_size = std::max<std::size_t>(options.chunk_size, 1);
+    const std::size_t chunks = (records.size() + chunk_size - 1) / chunk_size;
+    const std::size_t hardware_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    const std::size_t threads = std::min(options.threads != 0 ? options.threads : hardware_threads, chunks);
+
+    std::atomic<std::size_t> next_chunk{0};
+    std::vector<std::vector<batch_error>> errors(std::max<std::size_t>(threads, 1));
+
+    const auto work = [&](std::vector<batch_error> &worker_errors) {
+        for (auto chunk = next_chunk.fetch_add(1, std::memory_order_relaxed); chunk < chunks;
+             chunk = next_chunk.fetch_add(1, std::memory_order_relaxed))
+        {
+            const auto end = std::min(records.size(), (chunk + 1) * chunk_size);
+            for (auto i = chunk * chunk_size; i < end; ++i)
+            {
+                try
+                {
+                    parse_into(records[i], values[i]);
+                }
+                catch (const std::exception &e)
+                {
+                    values[i] = T{};
+                    worker_errors.push_back({i, static_cast<std::size_t>(records[i].data() - input.data()), e.what()});
+                }
+                catch (...)
+                {
+                    // a from_json may throw anything, it must not escape the worker thread
+                    values[i] = T{};
+                    worker_errors.push_back(
+                        {i, static_cast<std::size_t>(records[i].data() - input.data()), "unknown exception"});
+                }
+            }
+        }
+    };
+
+    if (threads <= 1)
+        work(errors[0]);
+    else
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        // if a thread can't be started the std::system_error is only rethrown after the started ones took the
+        // remaining chunks
+        const thread_joiner joiner(workers);
+        for (std::size_t i = 1; i < threads; ++i)
+            workers.emplace_back(work, std::ref(errors[i]));
+        // the calling thread works as well
+        work(errors[0]);
+    }
+
+    std::vector<batch_error> merged;
+    for (auto &worker_errors : errors)
+        std::move(worker_errors.begin(), worker_errors.end(), std::back_inserter(merged));
+    std::sort(merged.begin(), merged.end(),
+              [](const batch_error &lhs, const batch_error &rhs) { return lhs.index < rhs.index; });
+    return merged;
+}
+} // namespace detail
+
+// @summary decodes every record of input into a T in parallel, the values keep the input order. A record which can't
+// be decoded is reported in errors and doesn't stop the batch, if the input can't be split into records at all a
+// nlohmann::json::parse_error is thrown, if a worker thread can't be started a std::system_error
+template <typename T>
+batch_result<T> decode_batch(std::string_view input, batch_format format, const batch_options &options = {})
+{
+    const auto records = detail::split_records(input, format);
+
+    batch_result<T> result;
+    result.values.resize(records.size());
+    result.errors = detail::decode_records(input, records, result.values, options);
+    return result;
+}
+
+// @summary the same as decode_batch, but maps the file into memory instead of reading it
+template <typename T>
+batch_result<T> decode_batch_file(const std::string &path, batch_format format, const batch_options &options = {})
+{
+    const mapped_file file(path);
+    return decode_batch<T>(file.view(), format, options);
+}
+} // namespace json_ext
@@ -0,0 +1,24 @@
+#include <cstdlib>
+#include <new>
+
+#include "./utils.hpp"
+
+std::size_t global_allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    ++global_allocations;
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,123 @@
+#include <array>
+#include <memory_resource>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+struct GenericPoint
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT_TAGGED(GenericPoint, "point",
+        (int, x)
+        (int, y, 0)
+    )
+    // clang-format on
+};
+
+struct GenericCircle
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_TAGGED(GenericCircle, "circle",
+        (GenericPoint, center)
+        (double, radius)
+    )
+    // clang-format on
+};
+
+using GenericShape = std::variant<GenericPoint, GenericCircle>;
+
+struct GenericScene
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(GenericScene,
+        (std::string, name)
+        (GenericShape, first)
+        (GenericShape, second)
+        (std::optional<std::string>, comment, std::nullopt)
+        (std::optional<int>, layer, 1)
+    )
+    // clang-format on
+};
+
+TEST(TestBasicJson, OkayOrderedJson)
+{
+    const GenericScene scene{"scene", GenericPoint{1, 2}, GenericCircle{{3, 4}, 0.5}, "comment", std::nullopt};
+
+    // ordered_json keeps the declaration order of the members
+    nlohmann::ordered_json j = scene;
+    EXPECT_EQ(j.dump(), R"({"name":"scene","first":{"x":1,"y":2,"type":"point"},)"
+                        R"("second":{"center":{"x":3,"y":4,"type":"point"},"radius":0.5,"type":"circle"},)"
+                        R"("comment":"comment","layer":null})");
+
+    const auto parsed = j.get<GenericScene>();
+    EXPECT_EQ(nlohmann::json(parsed), nlohmann::json(scene));
+    EXPECT_TRUE(json_ext::can_parse<GenericScene>(j));
+
+    auto without_tag = nlohmann::ordered_json::parse(R"({"name":"n","first":{"x":1},"second":{"x":1,"z":1}})");
+    EXPECT_FALSE(json_ext::can_parse<GenericScene>(without_tag));
+    EXPECT_EX(without_tag.get<GenericScene>(),
+              "[json.exception.other_error.601] unable to find matching variant for object");
+}
+
+// the keys and strings are longer than the small string buffer, so they have to be allocated
+struct GenericNamedScene
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(GenericNamedScene,
+        (GenericScene, scene_behind_a_long_key)
+    )
+    // clang-format on
+};
+
+TEST(TestBasicJson, OkayArena)
+{
+    const GenericNamedScene scene{{"a scene with a long name", GenericPoint{1, 2}, GenericCircle{{3, 4}, 0.5},
+                                   "a comment which doesn't fit into the small string buffer", std::nullopt}};
+    // the members already hold strings of the decoded size, so decoding into it doesn't allocate
+    GenericNamedScene parsed = scene;
+
+    // the destructor of basic_json moves nested values to a temporary std::vector, which doesn't use the arena, a
+    // nlohmann::json of the same shape allocates the same
+    std::size_t destructor_allocations;
+    {
+        nlohmann::json j = scene;
+        nlohmann::json again = scene;
+        const auto before = global_allocations;
+        j = nullptr;
+        again = nullptr;
+        destructor_allocations = global_allocations - before;
+    }
+
+    // nothing else may fall back to the heap, the upstream of the arena throws on every allocation
+    std::array<std::byte, 16 * 1024> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    {
+        json_ext::arena_scope scope(arena);
+
+        const auto before = global_allocations;
+        bool is_equal;
+        {
+            // encode
+            json_ext::arena_json j = scene;
+            // decode
+            j.get_to(parsed);
+            json_ext::arena_json again = parsed;
+            is_equal = j == again;
+            // destroy
+        }
+        const auto after = global_allocations;
+
+        EXPECT_EQ(after - before, destructor_allocations);
+        EXPECT_TRUE(is_equal);
+    }
+    EXPECT_EQ(nlohmann::json(parsed), nlohmann::json(scene));
+
+    // allocations outside of a scope go to the default resource
+    json_ext::arena_json j = scene;
+    EXPECT_EQ(std::string_view(j.dump()), nlohmann::json(scene).dump());
+}
@@ -0,0 +1,172 @@
+#include <cstdio>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+#include <nlohmann/json_ext_batch.hpp>
+
+#include "./utils.hpp"
+
+struct BatchRecord
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(BatchRecord,
+        (int, id)
+        (std::string, text, "")
+        (std::vector<int>, values, {})
+    )
+    // clang-format on
+};
+
+static std::string make_records(std::size_t count, const char *separator)
+{
+    std::string out;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (i != 0)
+            out += separator;
+        BatchRecord record{static_cast<int>(i), "text, with [brackets] {and} \"quotes\" \\", {1, 2}};
+        out += nlohmann::json(record).dump();
+    }
+    return out;
+}
+
+TEST(TestBatch, OkayArray)
+{
+    const auto input = " [" + make_records(1000, ",\n ") + "] \n";
+    for (std::size_t threads : {1, 4})
+    {
+        const auto result = json_ext::decode_batch<BatchRecord>(input, json_ext::batch_format::array, {threads, 7});
+        ASSERT_EQ(result.values.size(), 1000);
+        EXPECT_TRUE(result.errors.empty());
+        for (std::size_t i = 0; i < result.values.size(); ++i)
+            EXPECT_EQ(result.values[i].id, static_cast<int>(i));
+        EXPECT_EQ(result.values[3].text, "text, with [brackets] {and} \"quotes\" \\");
+    }
+
+    EXPECT_TRUE(json_ext::decode_batch<BatchRecord>(" [ ] ", json_ext::batch_format::array).values.empty());
+}
+
+TEST(TestBatch, OkayNdjson)
+{
+    const auto input = make_records(1000, "\r\n") + "\n\n";
+    const auto result = json_ext::decode_batch<BatchRecord>(input, json_ext::batch_format::ndjson, {4, 16});
+    ASSERT_EQ(result.values.size(), 1000);
+    EXPECT_TRUE(result.errors.empty());
+    EXPECT_EQ(result.values.back().id, 999);
+}
+
+TEST(TestBatch, OkayFile)
+{
+    char path[] = "/tmp/json_ext_batch_XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    std::ofstream(path) << make_records(100, "\n");
+
+    const auto result = json_ext::decode_batch_file<BatchRecord>(path, json_ext::batch_format::ndjson);
+    EXPECT_EQ(result.values.size(), 100);
+    EXPECT_TRUE(result.errors.empty());
+
+    std::ofstream(path, std::ios::trunc).flush();
+    EXPECT_TRUE(json_ext::decode_batch_file<BatchRecord>(path, json_ext::batch_format::ndjson).values.empty());
+    std::remove(path);
+
+    EXPECT_THROW(json_ext::decode_batch_file<BatchRecord>(path, json_ext::batch_format::ndjson), std::system_error);
+}
+
+static std::size_t split_error_byte(const std::string &input)
+{
+    try
+    {
+        json_ext::decode_batch<BatchRecord>(input, json_ext::batch_format::array);
+    }
+    catch (const nlohmann::json::parse_error &e)
+    {
+        return e.byte;
+    }
+    return 0;
+}
+
+static std::size_t parse_error_byte(const std::string &input)
+{
+    try
+    {
+        [[maybe_unused]] const auto parsed = nlohmann::json::parse(input);
+    }
+    catch (const nlohmann::json::parse_error &e)
+    {
+        return e.byte;
+    }
+    return 0;
+}
+
+TEST(TestBatch, FailRecords)
+{
+    const std::string input = R"([{"id": 0}, {"id": "1"}, {"id": 2, "unknown": 1}, {"id": 3}, tru])";
+    const auto result = json_ext::decode_batch<BatchRecord>(input, json_ext::batch_format::array, {2, 1});
+
+    // the other records are decoded anyway
+    ASSERT_EQ(result.values.size(), 5);
+    EXPECT_EQ(result.values[3].id, 3);
+
+    ASSERT_EQ(result.errors.size(), 3);
+    EXPECT_EQ(result.errors[0].index, 1);
+    EXPECT_EQ(result.errors[0].offset, input.find(R"({"id": "1"})"));
+    EXPECT_EQ(result.errors[0].message, "[json.exception.type_error.302] type must be number, but is string");
+    EXPECT_EQ(result.errors[1].index, 2);
+    EXPECT_EQ(result.errors[1].message, "[json.exception.other_error.600] key 'unknown' not present in reflected keys");
+    EXPECT_EQ(result.errors[2].index, 4);
+
+    EXPECT_EX(json_ext::decode_batch<BatchRecord>(R"([{"id": 0})", json_ext::batch_format::array),
+              "[json.exception.parse_error.101] parse error at byte 11: syntax error while splitting records: "
+              "unexpected end of input, expected ']'");
+    EXPECT_THROW(json_ext::decode_batch<BatchRecord>(R"({"id": 0})", json_ext::batch_format::array),
+                 nlohmann::json::parse_error);
+    EXPECT_THROW(json_ext::decode_batch<BatchRecord>(R"([1] [2])", json_ext::batch_format::array),
+                 nlohmann::json::parse_error);
+
+    // an empty element isn't a record which fails, the input isn't json
+    EXPECT_EX(json_ext::decode_batch<BatchRecord>(R"([{"id": 0}, ])", json_ext::batch_format::array),
+              "[json.exception.parse_error.101] parse error at byte 13: syntax error while splitting records: "
+              "unexpected ']'");
+    EXPECT_EX(json_ext::decode_batch<BatchRecord>(R"([,])", json_ext::batch_format::array),
+              "[json.exception.parse_error.101] parse error at byte 2: syntax error while splitting records: "
+              "unexpected ','");
+    EXPECT_THROW(json_ext::decode_batch<BatchRecord>(R"([{"id": 0},,{"id": 1}])", json_ext::batch_format::array),
+                 nlohmann::json::parse_error);
+
+    // the byte offsets are 1-based, the same as nlohmann::json reports for the same input
+    for (const std::string malformed : {R"([{"id": 0})", R"([{"id": 0}, ])", R"([,])", R"([{"id": 0},,{"id": 1}])"})
+        EXPECT_EQ(split_error_byte(malformed), parse_error_byte(malformed)) << malformed;
+}
+
+// from_json throws something which isn't a std::exception
+struct BatchThrowsInt
+{
+    friend void from_json(const nlohmann::json &, BatchThrowsInt &)
+    {
+        throw 42;
+    }
+};
+
+struct BatchCustomRecord
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(BatchCustomRecord,
+        (std::optional<BatchThrowsInt>, custom, std::nullopt)
+    )
+    // clang-format on
+};
+
+TEST(TestBatch, FailUnknownException)
+{
+    const auto result =
+        json_ext::decode_batch<BatchCustomRecord>("{}\n{\"custom\": 1}\n{}", json_ext::batch_format::ndjson, {2, 1});
+    ASSERT_EQ(result.values.size(), 3);
+    ASSERT_EQ(result.errors.size(), 1);
+    EXPECT_EQ(result.errors[0].index, 1);
+    EXPECT_EQ(result.errors[0].message, "unknown exception");
+}
@@ -0,0 +1,125 @@
+#include <cmath>
+#include <limits>
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+
+struct BinaryInner
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT_TAGGED(BinaryInner, "inner",
+        (std::string, text)
+        (int, number, 1)
+    )
+    // clang-format on
+};
+
+struct BinaryOther
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_TAGGED(BinaryOther, "other",
+        (std::vector<double>, values)
+    )
+    // clang-format on
+};
+
+using BinaryEither = std::variant<BinaryInner, BinaryOther>;
+using BinaryMap = std::map<std::string, int>;
+
+struct BinaryOuter
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(BinaryOuter,
+        (std::vector<std::int64_t>, integers, {})
+        (std::vector<std::uint64_t>, unsigneds, {})
+        (std::vector<double>, floats, {})
+        (std::vector<std::string>, strings, {})
+        (bool, flag, true)
+        (float, ratio, 0.1f)
+        (std::optional<BinaryInner>, inner)
+        (std::optional<BinaryInner>, empty)
+        (std::vector<BinaryEither>, eithers, {})
+        (BinaryMap, map, {})
+        (json, raw, nullptr)
+    )
+    // clang-format on
+};
+
+static BinaryOuter make_outer()
+{
+    BinaryOuter obj;
+    // every boundary of the integer encodings of both formats
+    const std::vector<std::int64_t> boundaries = {
+        0, 23, 24, 127, 128, 255, 256, 65535, 65536, 4294967295, 4294967296, std::numeric_limits<std::int64_t>::max()};
+    for (const auto boundary : boundaries)
+    {
+        obj.integers.push_back(boundary);
+        obj.integers.push_back(-boundary - 1);
+        obj.integers.push_back(-boundary);
+    }
+    obj.integers.push_back(-32);
+    obj.integers.push_back(-33);
+    obj.unsigneds = {0, 127, 128, std::numeric_limits<std::uint64_t>::max()};
+    obj.floats = {0.0, -0.0, 0.5, 0.1, 1e300, -1e-300, std::numeric_limits<double>::infinity(), std::nan("")};
+    obj.strings = {"", std::string(23, 'a'), std::string(24, 'b'), std::string(31, 'c'), std::string(32, 'd'),
+                   std::string(256, 'e'), std::string(70000, 'f'), "\xff not utf-8"};
+    obj.inner = BinaryInner{"inner", 2};
+    obj.eithers = {BinaryInner{"a"}, BinaryOther{{1.0, 2.5}}};
+    for (int i = 0; i < 20; ++i)
+        obj.map[std::to_string(i)] = i;
+    obj.raw = JSON({"b" : [ 1, 2 ], "a" : null});
+    return obj;
+}
+
+TEST(TestBinary, OkaySameAsNlohmann)
+{
+    const auto obj = make_outer();
+
+    EXPECT_EQ(json_ext::to_msgpack(obj), json::to_msgpack(json(obj)));
+    EXPECT_EQ(json_ext::to_cbor(obj), json::to_cbor(json(obj)));
+    EXPECT_EQ(json_ext::to_msgpack(BinaryOuter{}), json::to_msgpack(json(BinaryOuter{})));
+    EXPECT_EQ(json_ext::to_cbor(BinaryOuter{}), json::to_cbor(json(BinaryOuter{})));
+
+    // appends to the buffer
+    std::vector<std::uint8_t> out = {42};
+    json_ext::write_binary<json_ext::binary_format::msgpack>(obj.inner, out);
+    EXPECT_EQ(out.size(), 1 + json::to_msgpack(json(obj.inner)).size());
+}
+
+TEST(TestBinary, OkayRoundTrip)
+{
+    auto obj = make_outer();
+    // NaN isn't equal to itself
+    obj.floats.pop_back();
+
+    const auto from_msgpack = json_ext::from_msgpack<BinaryOuter>(json_ext::to_msgpack(obj));
+    EXPECT_EQ(json(from_msgpack), json(obj));
+
+    const auto from_cbor = json_ext::from_cbor<BinaryOuter>(json_ext::to_cbor(obj));
+    EXPECT_EQ(json(from_cbor), json(obj));
+
+    const auto either = json_ext::from_cbor<BinaryEither>(json_ext::to_cbor(BinaryEither(BinaryOther{{1.5}})));
+    ASSERT_TRUE(std::holds_alternative<BinaryOther>(either));
+    EXPECT_EQ(std::get<BinaryOther>(either).values, std::vector<double>({1.5}));
+}
+
+TEST(TestBinary, FailSameAsNlohmann)
+{
+    const auto wrong_type = json::to_msgpack(JSON({"text" : 1}));
+    EXPECT_EX(json_ext::from_msgpack<BinaryInner>(wrong_type),
+              "[json.exception.type_error.302] type must be string, but is number");
+
+    const auto wrong_tag = json::to_cbor(JSON({"text" : "a", "type" : "other"}));
+    EXPECT_EX(json_ext::from_cbor<BinaryInner>(wrong_tag),
+              "[json.exception.other_error.602] expected type 'inner' but got: \"other\"");
+
+    const std::vector<std::uint8_t> truncated = {0x81, 0xA1};
+    EXPECT_THROW(json_ext::from_msgpack<BinaryInner>(truncated), json::parse_error);
+}
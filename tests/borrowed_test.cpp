@@ -0,0 +1,202 @@
+#include <array>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+
+struct BorrowedHeader
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(BorrowedHeader,
+        (std::string_view, name)
+        (std::string_view, value)
+    )
+    // clang-format on
+};
+
+struct BorrowedRequest
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT_TAGGED(BorrowedRequest, "request",
+        (std::string_view, method)
+        (std::string_view, path)
+        (std::vector<BorrowedHeader>, headers, {})
+        (std::optional<std::string_view>, body, std::nullopt)
+        (int, timeout, 30)
+        (std::string, owned, "")
+    )
+    // clang-format on
+};
+
+struct BorrowedAliased
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(BorrowedAliased,
+        (std::string_view, name, , "n")
+    )
+    // clang-format on
+};
+
+static bool points_into(std::string_view view, std::string_view input)
+{
+    return view.data() >= input.data() && view.data() + view.size() <= input.data() + input.size();
+}
+
+TEST(TestBorrowed, Okay)
+{
+    const std::string input = R"({"type": "request", "method": "GET", "path": "/index.html",)"
+                              R"( "headers": [{"name": "Accept", "value": "text/html"}], "owned": "copy"})";
+    std::array<std::byte, 1024> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    const auto before = global_allocations;
+    BorrowedRequest request;
+    json_ext::parse_borrowed(input, request, arena);
+    const auto after = global_allocations;
+
+    EXPECT_EQ(request.method, "GET");
+    EXPECT_EQ(request.path, "/index.html");
+    ASSERT_EQ(request.headers.size(), 1);
+    EXPECT_EQ(request.headers[0].name, "Accept");
+    EXPECT_EQ(request.headers[0].value, "text/html");
+    EXPECT_FALSE(request.body.has_value());
+    EXPECT_EQ(request.timeout, 30);
+    EXPECT_EQ(request.owned, "copy");
+
+    EXPECT_TRUE(points_into(request.method, input));
+    EXPECT_TRUE(points_into(request.headers[0].value, input));
+    // only the vector of headers is allocated
+    EXPECT_EQ(after - before, 1);
+    // parse_into would leave the views dangling, they would point into its temporary strings
+    auto expected = json::parse(input);
+    expected["body"] = nullptr;
+    expected["timeout"] = 30;
+    EXPECT_EQ(json(request), expected);
+}
+
+TEST(TestBorrowed, OkayEscaped)
+{
+    const std::string input =
+        R"({"method": "P\"OST", "path": "/café/😀", "body": "line\nline\t\\ \/", "headers": []})";
+    std::pmr::monotonic_buffer_resource arena;
+
+    const auto request = json_ext::parse_borrowed<BorrowedRequest>(input, arena);
+    const auto expected = json::parse(input);
+    EXPECT_EQ(request.method, expected["method"].get<std::string>());
+    EXPECT_EQ(request.path, expected["path"].get<std::string>());
+    EXPECT_EQ(*request.body, expected["body"].get<std::string>());
+    EXPECT_FALSE(points_into(request.method, input));
+
+    // non-ascii without escapes is borrowed
+    const std::string utf8 = R"({"method": "caf)"
+                             "\xC3\xA9"
+                             R"(", "path": ""})";
+    const auto borrowed = json_ext::parse_borrowed<BorrowedRequest>(utf8, arena);
+    EXPECT_EQ(borrowed.method, "caf\xC3\xA9");
+    EXPECT_TRUE(points_into(borrowed.method, utf8));
+}
+
+// @summary the error of parse_borrowed, which has to be the one of parse_into
+template <typename T> std::string both_fail(const std::string &input)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    std::string borrowed_error;
+    std::string parse_error;
+    try
+    {
+        json_ext::parse_borrowed<T>(input, arena);
+    }
+    catch (const nlohmann::json::exception &e)
+    {
+        borrowed_error = e.what();
+    }
+    try
+    {
+        json_ext::parse_into<T>(input);
+    }
+    catch (const nlohmann::json::exception &e)
+    {
+        parse_error = e.what();
+    }
+    EXPECT_FALSE(borrowed_error.empty()) << input;
+    EXPECT_EQ(borrowed_error, parse_error) << input;
+    return borrowed_error;
+}
+
+TEST(TestBorrowed, FailSameAsParseInto)
+{
+    const auto both_fail = [](const std::string &input) { return ::both_fail<BorrowedRequest>(input); };
+
+    // the same errors at the same position in the input
+    EXPECT_EQ(both_fail(R"({"path": "/"})"), "[json.exception.out_of_range.403] key 'method' not found");
+    EXPECT_EQ(both_fail(R"({"method": 1, "path": "/"})"),
+              "[json.exception.type_error.302] type must be string, but is number");
+    EXPECT_EQ(both_fail(R"({"method": "GET", "path": "/", "headers": {}})"),
+              "[json.exception.type_error.302] type must be array, but is object");
+    EXPECT_EQ(both_fail(R"({"method": "GET", "path": "/", "x": 1})"),
+              "[json.exception.other_error.600] key 'x' not present in reflected keys");
+    EXPECT_EQ(both_fail(R"({"type": "response", "method": "GET", "path": "/"})"),
+              "[json.exception.other_error.602] expected type 'request' but got: \"response\"");
+    EXPECT_EQ(both_fail(R"({"method": "GET", "path": "/", "body": nul})"),
+              "[json.exception.parse_error.101] parse error at line 1, column 43: syntax error while parsing value - "
+              "invalid literal; last read: '\"body\": nul}'");
+    EXPECT_EQ(both_fail(R"({"method": "\x", "path": "/"})"),
+              "[json.exception.parse_error.101] parse error at line 1, column 14: syntax error while parsing value - "
+              "invalid string: forbidden character after backslash; last read: '\"\\x'");
+    EXPECT_EQ(both_fail("{\"method\": \"\xC3(\", \"path\": \"/\"}"),
+              "[json.exception.parse_error.101] parse error at line 1, column 14: syntax error while parsing value - "
+              "invalid string: ill-formed UTF-8 byte; last read: '\"\xC3('");
+}
+
+TEST(TestBorrowed, FailInvalidSkippedValue)
+{
+    // the values of unknown keys are skipped, but they are still checked
+    for (const auto *junk : {"tru", "[1,,]", "{\"k\" 1}", "-", "01", "\"\\x\"", "\"\xC3(\"", "[\"\\ude00\"]"})
+    {
+        const auto error = both_fail<BorrowedHeader>(std::string(R"({"name": "a", "junk": )") + junk + "}");
+        EXPECT_EQ(error.rfind("[json.exception.parse_error.101]", 0), 0) << error;
+    }
+    EXPECT_EQ(both_fail<BorrowedHeader>(R"({"name": "a", "junk": , "value": "b"})"),
+              "[json.exception.parse_error.101] parse error at line 1, column 23: syntax error while parsing value - "
+              "unexpected ','; expected '[', '{', or a literal");
+
+    // the same for the value of an alias, which loses to the name of its member
+    EXPECT_EQ(both_fail<BorrowedAliased>(R"({"name": "a", "n": [1,,]})").rfind("[json.exception.parse_error.101]", 0),
+              0);
+
+    std::pmr::monotonic_buffer_resource arena;
+    const auto header = json_ext::parse_borrowed<BorrowedHeader>(
+        R"({"name": "a", "junk": {"k": [1, -2.5e3, true, null, "\u00e9"]}, "value": "b"})", arena);
+    EXPECT_EQ(header.name, "a");
+    EXPECT_EQ(header.value, "b");
+}
+
+TEST(TestBorrowed, OkayContainers)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    const std::string input = R"([["a", "bé"], null, ["😀"]])";
+    using Values = std::vector<std::optional<std::vector<std::string_view>>>;
+    const auto values = json_ext::parse_borrowed<Values>(input, arena);
+    ASSERT_EQ(values.size(), 3);
+    EXPECT_EQ((*values[0])[0], "a");
+    EXPECT_EQ((*values[0])[1], "b\xC3\xA9");
+    EXPECT_FALSE(values[1].has_value());
+    EXPECT_EQ((*values[2])[0], "\xF0\x9F\x98\x80");
+
+    EXPECT_EQ(json_ext::parse_borrowed<std::string_view>(R"("\"quoted\"")", arena), "\"quoted\"");
+    EXPECT_EX(json_ext::parse_borrowed<std::string_view>(R"("\ude00")", arena),
+              "[json.exception.parse_error.101] parse error at line 1, column 7: syntax error while parsing value - "
+              "invalid string: surrogate U+DC00..U+DFFF must follow U+D800..U+DBFF; last read: '\"\\ude00'");
+    EXPECT_EX(json_ext::parse_borrowed<std::optional<std::string_view>>("nulx", arena),
+              "[json.exception.parse_error.101] parse error at line 1, column 4: syntax error while parsing value - "
+              "invalid literal; last read: 'nulx'");
+}
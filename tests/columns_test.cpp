@@ -0,0 +1,179 @@
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+
+struct ColumnTrade
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_TAGGED(ColumnTrade, "trade",
+        (std::string, symbol)
+        (double, price)
+        (std::int64_t, quantity, 1)
+        (std::optional<double>, fee, std::nullopt)
+        (bool, buy, true, "b")
+        (std::vector<std::string>, venues, {})
+    )
+    // clang-format on
+};
+
+using ColumnTrades = json_ext::columns<ColumnTrade>;
+
+static const std::string input = R"([
+    {"symbol": "A", "price": 1.5, "quantity": 10, "fee": 0.1, "b": false, "venues": ["x", "y"]},
+    {"symbol": "B", "price": 2.5, "type": "trade", "unknown": {"nested": [1]}},
+    {"symbol": "C", "price": 3.5, "fee": null, "buy": true}
+])";
+
+static std::vector<bool> bits(const json_ext::presence_bitmap &presence)
+{
+    std::vector<bool> bits;
+    for (std::size_t i = 0; i < presence.size(); ++i)
+        bits.push_back(presence.test(i));
+    return bits;
+}
+
+static void expect_columns(const ColumnTrades &trades)
+{
+    ASSERT_EQ(trades.size(), 3);
+    EXPECT_EQ(trades.column<&ColumnTrade::symbol>(), (std::vector<std::string>{"A", "B", "C"}));
+    EXPECT_EQ(trades.column<&ColumnTrade::price>(), (std::vector<double>{1.5, 2.5, 3.5}));
+    EXPECT_EQ(trades.column<&ColumnTrade::quantity>(), (std::vector<std::int64_t>{10, 1, 1}));
+    EXPECT_EQ(trades.column<&ColumnTrade::fee>(), (std::vector<double>{0.1, 0, 0}));
+    // a bool column stores one byte per row
+    const auto &buy = trades.column<&ColumnTrade::buy>();
+    static_assert(std::is_same_v<std::decay_t<decltype(buy)>, std::vector<json_ext::column_bool>>);
+    EXPECT_EQ(std::vector<bool>(buy.begin(), buy.end()), (std::vector<bool>{false, true, true}));
+    EXPECT_TRUE(buy.data()[1].value);
+    EXPECT_EQ(trades.column<&ColumnTrade::venues>()[0], (std::vector<std::string>{"x", "y"}));
+
+    // defaulted members are present if their key was given, optionals if they hold a value
+    EXPECT_EQ(bits(trades.presence<&ColumnTrade::quantity>()), (std::vector<bool>{true, false, false}));
+    EXPECT_EQ(bits(trades.presence<&ColumnTrade::fee>()), (std::vector<bool>{true, false, false}));
+    EXPECT_EQ(bits(trades.presence<&ColumnTrade::buy>()), (std::vector<bool>{true, false, true}));
+    EXPECT_EQ(trades.presence<&ColumnTrade::venues>().count(), 1);
+
+    const auto rows = json::parse(input).get<std::vector<ColumnTrade>>();
+    for (std::size_t i = 0; i < rows.size(); ++i)
+        EXPECT_EQ(json(trades.row(i)), json(rows[i]));
+}
+
+TEST(TestColumns, OkayDecode)
+{
+    expect_columns(json_ext::parse_into<ColumnTrades>(input));
+    expect_columns(json::parse(input).get<ColumnTrades>());
+
+    // decoding replaces the rows
+    auto trades = json_ext::parse_into<ColumnTrades>(input);
+    json_ext::parse_into(input, trades);
+    expect_columns(trades);
+    json_ext::update(trades, json::parse(input));
+    expect_columns(trades);
+}
+
+TEST(TestColumns, OkayEncode)
+{
+    const auto rows = json::parse(input).get<std::vector<ColumnTrade>>();
+    const auto trades = json_ext::parse_into<ColumnTrades>(input);
+    EXPECT_EQ(json_ext::dump(trades), json_ext::dump(rows));
+    EXPECT_EQ(json(trades), json(rows));
+
+    ColumnTrades pushed;
+    for (const auto &row : rows)
+        pushed.push_back(row);
+    EXPECT_EQ(json_ext::dump(pushed), json_ext::dump(rows));
+    // a T gives every member
+    EXPECT_EQ(pushed.presence<&ColumnTrade::quantity>().count(), 3);
+    EXPECT_EQ(bits(pushed.presence<&ColumnTrade::fee>()), (std::vector<bool>{true, false, false}));
+}
+
+TEST(TestColumns, OkayScan)
+{
+    ColumnTrades trades;
+    for (int i = 0; i < 200; ++i)
+        trades.push_back({"S", i * 0.5, i, i % 3 == 0 ? std::optional<double>(1) : std::nullopt, true, {}});
+
+    double sum = 0;
+    for (auto price : trades.column<&ColumnTrade::price>())
+        sum += price;
+    EXPECT_EQ(sum, 199 * 200 / 2 * 0.5);
+
+    // the fees of the rows without fee are 0
+    const auto &fees = trades.column<&ColumnTrade::fee>();
+    const auto &presence = trades.presence<&ColumnTrade::fee>();
+    EXPECT_EQ(presence.words().size(), 4);
+    EXPECT_EQ(presence.count(), 67);
+    double fee_sum = 0;
+    for (auto fee : fees)
+        fee_sum += fee;
+    EXPECT_EQ(fee_sum, 67);
+}
+
+struct ColumnDefaultFromMember
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(ColumnDefaultFromMember,
+        (std::string, name)
+        (int, a, 1)
+        (int, b, a + 1)
+        (std::string, label, name + "!")
+    )
+    // clang-format on
+};
+
+TEST(TestColumns, OkayDefaultFromMember)
+{
+    const std::string input = R"([{"name": "x", "a": 5}, {"name": "y"}, {"name": "z", "a": 7, "b": 0, "label": "l"}])";
+    using Columns = json_ext::columns<ColumnDefaultFromMember>;
+
+    // parse_into has no T per row, its defaults still see the decoded members of the row as get does
+    const auto parsed = json_ext::parse_into<Columns>(input);
+    EXPECT_EQ(parsed.column<&ColumnDefaultFromMember::b>(), (std::vector<int>{6, 2, 0}));
+    EXPECT_EQ(parsed.column<&ColumnDefaultFromMember::label>(), (std::vector<std::string>{"x!", "y!", "l"}));
+    EXPECT_EQ(json(parsed), json(json::parse(input).get<Columns>()));
+    EXPECT_EQ(json(parsed), json(json::parse(input).get<std::vector<ColumnDefaultFromMember>>()));
+}
+
+TEST(TestColumns, FailSameErrors)
+{
+    const auto expect_same_error = [](const std::string &text, const char *message) {
+        auto trades = json_ext::parse_into<ColumnTrades>(input);
+        EXPECT_EX(json_ext::parse_into(text, trades), message);
+        EXPECT_EX(json_ext::parse_into<std::vector<ColumnTrade>>(text), message);
+        // a failed decoding leaves no half decoded rows
+        EXPECT_TRUE(trades.empty());
+        EXPECT_TRUE(trades.column<&ColumnTrade::price>().empty());
+        EXPECT_EQ(trades.presence<&ColumnTrade::fee>().size(), 0);
+    };
+
+    expect_same_error(R"({"symbol": "A"})", "[json.exception.type_error.302] type must be array, but is object");
+    expect_same_error(R"([1])", "[json.exception.type_error.304] cannot use at() with number");
+    expect_same_error(R"([{"symbol": "A", "price": 1}, {"symbol": "B"}])",
+                      "[json.exception.out_of_range.403] key 'price' not found");
+    expect_same_error(R"([{"symbol": "A", "price": "1"}])",
+                      "[json.exception.type_error.302] type must be number, but is string");
+    expect_same_error(R"([{"symbol": "A", "price": 1, "type": "quote"}])",
+                      "[json.exception.other_error.602] expected type 'trade' but got: \"quote\"");
+    // the rows before the failing one are dropped as well
+    expect_same_error(R"([{"symbol": "A", "price": 1}, 1])",
+                      "[json.exception.type_error.304] cannot use at() with number");
+    expect_same_error(R"([{"symbol": "A", "price": 1}, {"symbol": "B", "price": true}])",
+                      "[json.exception.type_error.302] type must be number, but is boolean");
+    expect_same_error(R"([{"symbol": "A", "price": 1}, )",
+                      "[json.exception.parse_error.101] parse error at line 1, column 31: syntax error while parsing "
+                      "value - unexpected end of input; expected '[', '{', or a literal");
+
+    EXPECT_EX(json::parse(R"([{"symbol": "A"}])").get<ColumnTrades>(),
+              "[json.exception.out_of_range.403] key 'price' not found");
+    EXPECT_FALSE(json_ext::can_parse<ColumnTrades>(json::parse(R"([{"symbol": "A"}])")));
+    EXPECT_TRUE(json_ext::can_parse<ColumnTrades>(json::parse(input)));
+}
@@ -0,0 +1,195 @@
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+
+struct CompactLocation
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(CompactLocation,
+        (double, latitude, , "lat")
+        (double, longitude, , "lon")
+        (std::optional<double>, altitude, std::nullopt, "alt")
+    )
+    // clang-format on
+};
+
+struct CompactReading
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_TAGGED(CompactReading, "reading",
+        (std::string, sensor, , "s")
+        (double, value, 0.0, "v")
+        (std::optional<std::string>, unit, std::nullopt, "u")
+        (std::optional<int>, retries, 3)
+        (std::string, status, "ok")
+        (std::vector<int>, flags, {})
+        (std::optional<CompactLocation>, location, std::nullopt, "loc")
+    )
+    // clang-format on
+};
+
+static CompactReading make_reading()
+{
+    CompactReading reading;
+    reading.sensor = "t1";
+    reading.value = 21.5;
+    reading.retries.reset();
+    return reading;
+}
+
+static void expect_round_trip(const CompactReading &reading, const std::string &written)
+{
+    EXPECT_EQ(json(json::parse(written).get<CompactReading>()), json(reading));
+    EXPECT_EQ(json(json_ext::parse_into<CompactReading>(written)), json(reading));
+}
+
+TEST(TestCompact, OkayOmitEmptyOptionals)
+{
+    auto reading = make_reading();
+    auto written = json_ext::dump_compact(reading);
+    // retries has the default 3, so the empty optional has to be written
+    EXPECT_EQ(written, R"({"flags":[],"retries":null,"s":"t1","status":"ok","type":"reading","v":21.5})");
+    expect_round_trip(reading, written);
+
+    reading.unit = "C";
+    reading.location = CompactLocation{1.5, 2.5, std::nullopt};
+    written = json_ext::dump_compact(reading);
+    EXPECT_EQ(written, R"({"flags":[],"loc":{"lat":1.5,"lon":2.5},"retries":null,"s":"t1","status":"ok",)"
+                       R"("type":"reading","u":"C","v":21.5})");
+    expect_round_trip(reading, written);
+
+    // appends as write does
+    std::string out = "[";
+    json_ext::write_compact(reading.location, out);
+    EXPECT_EQ(out, R"([{"lat":1.5,"lon":2.5})");
+}
+
+TEST(TestCompact, OkayOmitDefaults)
+{
+    auto reading = make_reading();
+    json_ext::compact_options options;
+    options.omit_defaults = true;
+    options.use_aliases = false;
+
+    auto written = json_ext::dump_compact(reading, options);
+    EXPECT_EQ(written, R"({"retries":null,"sensor":"t1","type":"reading","value":21.5})");
+    expect_round_trip(reading, written);
+
+    reading.status = "degraded";
+    reading.flags = {4};
+    reading.retries = 3;
+    reading.value = 0;
+    written = json_ext::dump_compact(reading, options);
+    EXPECT_EQ(written, R"({"flags":[4],"sensor":"t1","status":"degraded","type":"reading"})");
+    expect_round_trip(reading, written);
+
+    // without omitting anything the output is the one of dump
+    options.omit_empty_optionals = false;
+    options.omit_defaults = false;
+    EXPECT_EQ(json_ext::dump_compact(reading, options), json(reading).dump());
+}
+
+static std::size_t evaluated_defaults = 0;
+
+static std::string counted_default()
+{
+    ++evaluated_defaults;
+    return "default";
+}
+
+struct CompactCounted
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(CompactCounted,
+        (std::string, name, counted_default())
+        (std::optional<int>, count, std::nullopt)
+    )
+    // clang-format on
+};
+
+TEST(TestCompact, OkayDefaultsOnlyEvaluatedIfNeeded)
+{
+    const CompactCounted value{"a", std::nullopt};
+    json_ext::compact_options options;
+    options.omit_empty_optionals = false;
+
+    evaluated_defaults = 0;
+    EXPECT_EQ(json_ext::dump_compact(value, options), R"({"count":null,"name":"a"})");
+    EXPECT_EQ(evaluated_defaults, 0);
+
+    // only the default of the empty optional is needed
+    options.omit_empty_optionals = true;
+    EXPECT_EQ(json_ext::dump_compact(value, options), R"({"name":"a"})");
+    EXPECT_EQ(evaluated_defaults, 0);
+
+    options.omit_defaults = true;
+    EXPECT_EQ(json_ext::dump_compact(value, options), R"({"name":"a"})");
+    EXPECT_EQ(evaluated_defaults, 1);
+}
+
+TEST(TestCompact, OkayAliases)
+{
+    // strict types accept the aliases and the names
+    EXPECT_EQ(json(JSON({"lat" : 1.0, "lon" : 2.0, "alt" : 3.0}).get<CompactLocation>()),
+              JSON({"latitude" : 1.0, "longitude" : 2.0, "altitude" : 3.0}));
+    EXPECT_TRUE(json_ext::can_parse<CompactLocation>(JSON({"lat" : 1.0, "longitude" : 2.0})));
+    EXPECT_FALSE(json_ext::can_parse<CompactLocation>(JSON({"lat" : 1.0, "lon" : 2.0, "x" : 3.0})));
+
+    // variants with aliased alternatives are probed
+    const auto variant = JSON({"lat" : 1.0, "lon" : 2.0}).get<std::variant<std::string, CompactLocation>>();
+    EXPECT_EQ(std::get<CompactLocation>(variant).longitude, 2.0);
+}
+
+TEST(TestCompact, OkayNameWinsOverAlias)
+{
+    // whatever the order of the keys, the name wins over the alias on every way of decoding
+    for (const std::string input : {R"({"lat": 2.0, "latitude": 1.0, "lon": 3.0, "lat": 4.0})",
+                                    R"({"latitude": 1.0, "lat": 2.0, "lon": 3.0})",
+                                    R"({"lat": 2.0, "lon": 3.0, "latitude": 1.0})"})
+    {
+        SCOPED_TRACE(input);
+        EXPECT_EQ(json::parse(input).get<CompactLocation>().latitude, 1.0);
+        EXPECT_EQ(json_ext::parse_into<CompactLocation>(input).latitude, 1.0);
+        EXPECT_EQ(json_ext::lazy_view<CompactLocation>(input).get<&CompactLocation::latitude>(), 1.0);
+
+        std::pmr::monotonic_buffer_resource arena;
+        EXPECT_EQ(json_ext::parse_borrowed<CompactLocation>(input, arena).latitude, 1.0);
+
+        CompactLocation updated{5.0, 6.0, std::nullopt};
+        json_ext::update(updated, json::parse(input));
+        EXPECT_EQ(updated.latitude, 1.0);
+
+        CompactLocation patched{5.0, 6.0, std::nullopt};
+        json_ext::apply_patch(patched, json::parse(input));
+        EXPECT_EQ(patched.latitude, 1.0);
+
+        const auto columns = json_ext::parse_into<json_ext::columns<CompactLocation>>("[" + input + "]");
+        EXPECT_EQ(columns.column<&CompactLocation::latitude>(), std::vector<double>{1.0});
+        EXPECT_EQ(json::parse("[" + input + "]").get<json_ext::columns<CompactLocation>>().row(0).latitude, 1.0);
+    }
+
+    // the last of duplicate aliases wins if the name is missing
+    EXPECT_EQ(json_ext::parse_into<CompactLocation>(R"({"lat": 2.0, "lon": 3.0, "lat": 4.0})").latitude, 4.0);
+}
+
+TEST(TestCompact, Fail)
+{
+    // errors name the member, not the alias
+    EXPECT_EX(JSON({"lat" : 1.0}).get<CompactLocation>(),
+              "[json.exception.out_of_range.403] key 'longitude' not found");
+    EXPECT_EX(JSON({"lat" : 1.0, "lon" : "east"}).get<CompactLocation>(),
+              "[json.exception.type_error.302] type must be number, but is string");
+    EXPECT_EX(json_ext::parse_into<CompactLocation>(R"({"lat":1.0})"),
+              "[json.exception.out_of_range.403] key 'longitude' not found");
+}
@@ -0,0 +1,98 @@
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+
+// clang-format off
+NLOHMANN_SERIALIZE_ENUM(Side,
+    (buy)
+    (sell)
+    (sell_short, "sell-short")
+)
+
+NLOHMANN_SERIALIZE_ENUM_AS_INTEGER(Venue,
+    (lit)
+    (dark)
+)
+// clang-format on
+
+struct EnumOrder
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(EnumOrder,
+        (Side, side)
+        (Venue, venue, Venue::lit)
+        (std::optional<Side>, hedge, std::nullopt)
+        (std::vector<Side>, history, {})
+    )
+    // clang-format on
+};
+
+TEST(TestEnum, OkayTables)
+{
+    static_assert(json_ext::detail::is_reflected_enum<Side>::value);
+    static_assert(!json_ext::detail::is_reflected_enum<json::value_t>::value);
+    static_assert(json_ext::detail::enum_table<Side>::reflection.names[2] == "sell-short");
+    static_assert(json_ext::detail::enum_table<Side>::names.find("sell") == 1);
+    static_assert(json_ext::detail::enum_table<Venue>::reflection.as_integer);
+    EXPECT_EQ(json_ext::detail::enumerator_name(Side::sell_short), "sell-short");
+}
+
+TEST(TestEnum, OkayAllPaths)
+{
+    const EnumOrder order{Side::sell_short, Venue::dark, Side::buy, {Side::buy, Side::sell}};
+    const auto expected =
+        JSON({"side" : "sell-short", "venue" : 1, "hedge" : "buy", "history" : [ "buy", "sell" ]});
+
+    EXPECT_EQ(json(order), expected);
+    EXPECT_EQ(json_ext::dump(order), expected.dump());
+    EXPECT_EQ(json_ext::to_msgpack(order), json::to_msgpack(expected));
+    EXPECT_EQ(json_ext::to_cbor(order), json::to_cbor(expected));
+
+    EXPECT_EQ(json(expected.get<EnumOrder>()), expected);
+    EXPECT_EQ(json(json_ext::parse_into<EnumOrder>(expected.dump())), expected);
+    EXPECT_EQ(json(json_ext::from_msgpack<EnumOrder>(json::to_msgpack(expected))), expected);
+    EXPECT_EQ(json(json_ext::try_get<EnumOrder>(expected).value()), expected);
+    EXPECT_EQ(json_ext::lazy_view<EnumOrder>(expected.dump()).get<&EnumOrder::side>(), Side::sell_short);
+
+    auto changed = order;
+    changed.side = Side::buy;
+    EXPECT_EQ(json_ext::diff(order, changed), JSON({"side" : "buy"}));
+
+    // the default is used as for every other member
+    EXPECT_EQ(JSON({"side" : "buy"}).get<EnumOrder>().venue, Venue::lit);
+}
+
+TEST(TestEnum, FailSameErrors)
+{
+    const auto both_fail = [](const json &j, const char *error) {
+        EXPECT_EX(j.get<EnumOrder>(), error);
+        EXPECT_EX(json_ext::parse_into<EnumOrder>(j.dump()), error);
+    };
+    both_fail(JSON({"side" : "hold"}), "[json.exception.other_error.603] no enumerator of Side for: \"hold\"");
+    both_fail(JSON({"side" : 1}), "[json.exception.type_error.302] type must be string, but is number");
+    both_fail(JSON({"side" : "buy", "venue" : 2}), "[json.exception.other_error.603] no enumerator of Venue for: 2");
+    both_fail(JSON({"side" : "buy", "venue" : -1}), "[json.exception.other_error.603] no enumerator of Venue for: -1");
+    both_fail(JSON({"side" : "buy", "venue" : 0.5}),
+              "[json.exception.other_error.603] no enumerator of Venue for: 0.5");
+    both_fail(JSON({"side" : "buy", "venue" : "lit"}),
+              "[json.exception.type_error.302] type must be number, but is string");
+
+    const auto result = json_ext::try_get<EnumOrder>(JSON({"side" : "buy", "history" : [ "sell", "hold" ]}));
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code, json_ext::decode_errc::unknown_enumerator);
+    EXPECT_EQ(result.error().message(), "/history/1: no enumerator of Side for: \"hold\"");
+
+    // values which aren't declared enumerators can't be written
+    EXPECT_EX(json(static_cast<Side>(7)), "[json.exception.other_error.603] no enumerator of Side for: 7");
+    EXPECT_EX(json_ext::dump(static_cast<Venue>(-1)),
+              "[json.exception.other_error.603] no enumerator of Venue for: -1");
+}
@@ -0,0 +1,150 @@
+// built as an executable of its own with JSON_EXT_INSTRUMENTATION defined, see CMakeLists.txt
+#include <algorithm>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+using json_ext::instrumentation::counter;
+
+struct InstrumentedPoint
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(InstrumentedPoint,
+        (int, x)
+        (int, y)
+    )
+    // clang-format on
+};
+
+struct InstrumentedLabel
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(InstrumentedLabel,
+        (std::string, text)
+    )
+    // clang-format on
+};
+
+using InstrumentedShape = std::variant<int, InstrumentedLabel, InstrumentedPoint>;
+
+struct InstrumentedDrawing
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(InstrumentedDrawing,
+        (std::vector<InstrumentedShape>, shapes)
+    )
+    // clang-format on
+};
+
+template <typename T> static json_ext::instrumentation::type_snapshot snapshot_of()
+{
+    const auto snapshots = json_ext::instrumentation::snapshot();
+    const auto name = json_ext::instrumentation::detail::type_name<T>();
+    const auto it = std::find_if(snapshots.begin(), snapshots.end(), [&](const auto &s) { return s.type == name; });
+    return it == snapshots.end() ? json_ext::instrumentation::type_snapshot{name} : *it;
+}
+
+// the counters are global, compare the differences
+template <typename T> static std::uint64_t delta(const json_ext::instrumentation::type_snapshot &before, counter c)
+{
+    return snapshot_of<T>()[c] - before[c];
+}
+
+TEST(TestInstrumentation, OkayTypeName)
+{
+    EXPECT_EQ(json_ext::instrumentation::detail::type_name<InstrumentedPoint>(), "InstrumentedPoint");
+    EXPECT_EQ(json_ext::instrumentation::detail::type_name<std::vector<int>>().substr(0, 12), "std::vector<");
+}
+
+TEST(TestInstrumentation, OkayCounters)
+{
+    const auto point = snapshot_of<InstrumentedPoint>();
+    const auto shape = snapshot_of<InstrumentedShape>();
+    const auto drawing = snapshot_of<InstrumentedDrawing>();
+
+    const auto j = JSON({"shapes" : [ 1, {"text" : "a"}, {"x" : 1, "y" : 2} ]});
+    const auto value = j.get<InstrumentedDrawing>();
+    EXPECT_EQ(delta<InstrumentedDrawing>(drawing, counter::decodes), 1);
+    EXPECT_EQ(delta<InstrumentedShape>(shape, counter::decodes), 3);
+    // int matches directly, the label second and the point third, every probe is counted
+    EXPECT_EQ(delta<InstrumentedShape>(shape, counter::alternatives_tried), 1 + 2 + 3);
+    // the point is probed by the label and decoded once
+    EXPECT_EQ(delta<InstrumentedPoint>(point, counter::decodes), 1);
+
+    EXPECT_EQ(json(value), j);
+    EXPECT_EQ(delta<InstrumentedDrawing>(drawing, counter::encodes), 1);
+    EXPECT_EQ(delta<InstrumentedShape>(shape, counter::encodes), 3);
+
+    const auto text = json_ext::dump(value);
+    EXPECT_EQ(delta<InstrumentedDrawing>(drawing, counter::encodes), 2);
+    EXPECT_EQ(delta<InstrumentedDrawing>(drawing, counter::encoded_bytes), text.size());
+
+    json_ext::parse_into<InstrumentedDrawing>(text);
+    EXPECT_EQ(delta<InstrumentedDrawing>(drawing, counter::decodes), 2);
+    EXPECT_EQ(delta<InstrumentedDrawing>(drawing, counter::decoded_bytes), text.size());
+}
+
+TEST(TestInstrumentation, OkayFailures)
+{
+    const auto point = snapshot_of<InstrumentedPoint>();
+    const auto shape = snapshot_of<InstrumentedShape>();
+
+    EXPECT_EX(JSON({"x" : 1, "y" : 2, "z" : 3}).get<InstrumentedPoint>(),
+              "[json.exception.other_error.600] key 'z' not present in reflected keys");
+    EXPECT_EX(JSON({"x" : 1}).get<InstrumentedPoint>(), "[json.exception.out_of_range.403] key 'y' not found");
+    EXPECT_EQ(delta<InstrumentedPoint>(point, counter::decodes), 2);
+    EXPECT_EQ(delta<InstrumentedPoint>(point, counter::decode_failures), 2);
+    EXPECT_EQ(delta<InstrumentedPoint>(point, counter::strict_rejections), 1);
+
+    // every decoder of a strict type counts its unknown keys
+    const auto before = snapshot_of<InstrumentedPoint>();
+    const std::string unknown = R"({"x": 1, "y": 2, "z": 3})";
+    EXPECT_ANY_THROW(json_ext::parse_into<InstrumentedPoint>(unknown));
+    EXPECT_ANY_THROW(json_ext::lazy_view<InstrumentedPoint>{unknown});
+    std::pmr::monotonic_buffer_resource arena;
+    EXPECT_ANY_THROW(json_ext::parse_borrowed<InstrumentedPoint>(unknown, arena));
+    InstrumentedPoint patched{1, 2};
+    EXPECT_ANY_THROW(json_ext::apply_patch(patched, json::parse(unknown)));
+    EXPECT_ANY_THROW(json_ext::parse_into<json_ext::columns<InstrumentedPoint>>("[" + unknown + "]"));
+    EXPECT_EQ(delta<InstrumentedPoint>(before, counter::strict_rejections), 5);
+
+    EXPECT_EX(json("text").get<InstrumentedShape>(),
+              "[json.exception.other_error.601] unable to find matching variant for string");
+    EXPECT_EQ(delta<InstrumentedShape>(shape, counter::decode_failures), 1);
+    EXPECT_EQ(delta<InstrumentedShape>(shape, counter::alternatives_tried), 3);
+}
+
+TEST(TestInstrumentation, OkayThreadsAndLatency)
+{
+    const auto before = snapshot_of<InstrumentedLabel>();
+    json_ext::instrumentation::record_latency(true);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i)
+                JSON({"text" : "label"}).get<InstrumentedLabel>();
+        });
+    for (auto &thread : threads)
+        thread.join();
+    json_ext::instrumentation::record_latency(false);
+
+    const auto after = snapshot_of<InstrumentedLabel>();
+    EXPECT_EQ(after[counter::decodes] - before[counter::decodes], 4000);
+    const auto sum = [](const auto &histogram) {
+        return std::accumulate(histogram.begin(), histogram.end(), std::uint64_t{0});
+    };
+    EXPECT_EQ(sum(after.decode_latency) - sum(before.decode_latency), 4000);
+    EXPECT_STREQ(json_ext::instrumentation::counter_name(counter::strict_rejections), "strict_rejections");
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+using json_ext::detail::is_valid_json;
+
+TEST(TestJsonLiteral, Syntax)
+{
+    static_assert(is_valid_json(R"({"a" : 1, "b" : [true, false, null], "c" : {"d" : "e"}})"));
+    static_assert(is_valid_json(R"( [ -0.5e+10, 0, 12, 1E3, "\"\\\/\b\f\n\r\t\u00ff" ] )"));
+    static_assert(is_valid_json(R"({})"));
+    static_assert(is_valid_json(R"([])"));
+    static_assert(is_valid_json(R"("")"));
+
+    static_assert(!is_valid_json(""));
+    static_assert(!is_valid_json(R"({"a" : 1,})"));
+    static_assert(!is_valid_json(R"({"a" 1})"));
+    static_assert(!is_valid_json(R"({a : 1})"));
+    static_assert(!is_valid_json(R"([1 2])"));
+    static_assert(!is_valid_json(R"([01])"));
+    static_assert(!is_valid_json(R"([1.])"));
+    static_assert(!is_valid_json(R"([1e])"));
+    static_assert(!is_valid_json(R"(["\x"])"));
+    static_assert(!is_valid_json(R"(["\u12"])"));
+    static_assert(!is_valid_json(R"(["a)"));
+    static_assert(!is_valid_json(R"(tru)"));
+    static_assert(!is_valid_json(R"({} {})"));
+}
+
+static const nlohmann::json &static_payload()
+{
+    return JSON_STATIC({"a" : 1, "b" : [ 1, 2 ], "c" : "\n"});
+}
+
+TEST(TestJsonLiteral, OkayStatic)
+{
+    EXPECT_EQ(static_payload(), JSON({"a" : 1, "b" : [ 1, 2 ], "c" : "\n"}));
+    // parsed once per call site, every call returns the same instance
+    EXPECT_EQ(&static_payload(), &static_payload());
+    // different call sites with the same text are different instances
+    EXPECT_NE(&JSON_STATIC({"a" : 1}), &JSON_STATIC({"a" : 1}));
+
+    auto copy = JSON_STATIC({"a" : 1});
+    copy["a"] = 2;
+    EXPECT_EQ(copy, JSON({"a" : 2}));
+}
@@ -0,0 +1,139 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+
+struct LazyHeader
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(LazyHeader,
+        (std::string, route)
+        (int, priority, 5)
+    )
+    // clang-format on
+};
+
+struct LazyMessage
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_TAGGED(LazyMessage, "message",
+        (LazyHeader, header)
+        (std::string, body)
+        (std::vector<int>, values, {})
+        (std::optional<std::string>, comment)
+    )
+    // clang-format on
+};
+
+struct LazyStrict
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(LazyStrict,
+        (int, id)
+    )
+    // clang-format on
+};
+
+TEST(TestLazyView, Okay)
+{
+    const std::string input =
+        R"( {"type": "message", "body": "with \"quotes\" and } ]",)"
+        R"( "header": {"route": "a.b", "extra": [1, {"x": "}"}]}, "comment": null, "unknown": [[], {}]} )";
+
+    const json_ext::lazy_view<LazyMessage> view(input);
+    EXPECT_EQ(view.raw(), input);
+    EXPECT_EQ(view.raw<&LazyMessage::body>(), R"("with \"quotes\" and } ]")");
+    EXPECT_TRUE(view.contains<&LazyMessage::header>());
+    EXPECT_FALSE(view.contains<&LazyMessage::values>());
+
+    EXPECT_EQ(view.get<&LazyMessage::header>().route, "a.b");
+    EXPECT_EQ(view.get<&LazyMessage::header>().priority, 5);
+    EXPECT_EQ(view.get<&LazyMessage::body>(), "with \"quotes\" and } ]");
+    EXPECT_TRUE(view.get<&LazyMessage::values>().empty());
+    EXPECT_FALSE(view.get<&LazyMessage::comment>().has_value());
+
+    EXPECT_EQ(json(view.to_value()), json(json::parse(input).get<LazyMessage>()));
+}
+
+TEST(TestLazyView, OkayDecodesOnce)
+{
+    const std::string input = R"({"header": {"route": "r"}, "body": "b", "comment": "c", "values": [1, 2]})";
+    const json_ext::lazy_view<LazyMessage> view(input);
+
+    const auto &route = view.get<&LazyMessage::header>().route;
+    EXPECT_EQ(&view.get<&LazyMessage::header>().route, &route);
+    EXPECT_EQ(view.to_value().values, std::vector<int>({1, 2}));
+
+    // escaped keys are decoded, the last value of a duplicate key wins
+    const json_ext::lazy_view<LazyStrict> escaped(R"({"id": 1, "i\u0064": 2})");
+    EXPECT_EQ(escaped.get<&LazyStrict::id>(), 2);
+    const json_ext::lazy_view<LazyStrict> duplicate(R"({"i\u0064": 1, "id": 2})");
+    EXPECT_EQ(duplicate.get<&LazyStrict::id>(), 2);
+}
+
+struct LazyDefaultFromMember
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(LazyDefaultFromMember,
+        (int, a, 1)
+        (int, b, a + 1)
+    )
+    // clang-format on
+};
+
+TEST(TestLazyView, OkayDefaultIndependentOfOrder)
+{
+    const std::string input = R"({"a": 5})";
+
+    // the default of b sees the decoded a, whichever member is read first
+    const json_ext::lazy_view<LazyDefaultFromMember> b_first(input);
+    EXPECT_EQ(b_first.get<&LazyDefaultFromMember::b>(), 6);
+    EXPECT_EQ(b_first.get<&LazyDefaultFromMember::a>(), 5);
+
+    const json_ext::lazy_view<LazyDefaultFromMember> a_first(input);
+    EXPECT_EQ(a_first.get<&LazyDefaultFromMember::a>(), 5);
+    EXPECT_EQ(a_first.get<&LazyDefaultFromMember::b>(), 6);
+
+    EXPECT_EQ(json(b_first.to_value()), json(json::parse(input).get<LazyDefaultFromMember>()));
+
+    // a missing member with default decodes the members declared before it, so their errors show up
+    const json_ext::lazy_view<LazyDefaultFromMember> invalid(R"({"a": "5"})");
+    EXPECT_EX(invalid.get<&LazyDefaultFromMember::b>(),
+              "[json.exception.type_error.302] type must be number, but is string");
+}
+
+TEST(TestLazyView, FailSameAsFromJson)
+{
+    // only the accessed member fails
+    const json_ext::lazy_view<LazyMessage> missing(R"({"header": {"route": "r"}, "values": ["x"]})");
+    EXPECT_EQ(missing.get<&LazyMessage::header>().route, "r");
+    EXPECT_EX(missing.get<&LazyMessage::body>(), "[json.exception.out_of_range.403] key 'body' not found");
+    EXPECT_EX(missing.get<&LazyMessage::values>(),
+              "[json.exception.type_error.302] type must be number, but is string");
+
+    EXPECT_EX(json_ext::lazy_view<LazyMessage>(R"({"type": "other"})"),
+              "[json.exception.other_error.602] expected type 'message' but got: \"other\"");
+    EXPECT_EX(json_ext::lazy_view<LazyStrict>(R"({"id": 1, "name": 2})"),
+              "[json.exception.other_error.600] key 'name' not present in reflected keys");
+    EXPECT_EX(json_ext::lazy_view<LazyStrict>("[1]"), "[json.exception.type_error.304] cannot use at() with array");
+}
+
+TEST(TestLazyView, FailSyntax)
+{
+    EXPECT_EX(json_ext::lazy_view<LazyStrict>(R"({"id" 1})"),
+              "[json.exception.parse_error.101] parse error at byte 7: syntax error while scanning object: "
+              "expected ':'");
+    EXPECT_EX(json_ext::lazy_view<LazyStrict>(R"({"id": [1, 2)"),
+              "[json.exception.parse_error.101] parse error at byte 13: syntax error while scanning object: unexpected "
+              "end of input, expected '}' or ']'");
+    EXPECT_EX(json_ext::lazy_view<LazyStrict>(R"({"id": 1} 2)"),
+              "[json.exception.parse_error.101] parse error at byte 11: syntax error while scanning object: unexpected "
+              "content after the value");
+}
@@ -0,0 +1,139 @@
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "utils.hpp"
+
+using nlohmann::json;
+
+struct MovedAttachment
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_TAGGED(MovedAttachment, "attachment",
+        (std::string, name)
+        (json::binary_t, blob)
+    )
+    // clang-format on
+};
+
+struct MovedLink
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_TAGGED(MovedLink, "link",
+        (std::string, url)
+    )
+    // clang-format on
+};
+
+using MovedPayload = std::variant<MovedAttachment, MovedLink>;
+
+struct MovedRecord
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(MovedRecord,
+        (std::string, message)
+        (std::vector<std::string>, lines)
+        (std::optional<std::string>, comment)
+        (MovedPayload, payload)
+        (std::vector<std::vector<std::string>>, table, {})
+        (json, extra, nullptr)
+    )
+    // clang-format on
+};
+
+// longer than any small string buffer, so a moved string keeps its buffer
+static std::string long_string(char c)
+{
+    return std::string(64, c);
+}
+
+static json make_record()
+{
+    json j = {{"message", long_string('m')},
+              {"lines", {long_string('a'), long_string('b')}},
+              {"comment", long_string('c')},
+              {"payload", {{"type", "attachment"}, {"name", long_string('n')}, {"blob", json::binary({1, 2, 3})}}},
+              {"table", {{long_string('t')}}},
+              {"extra", {{"nested", long_string('e')}}}};
+    return j;
+}
+
+TEST(TestMove, OkaySameAsCopy)
+{
+    const auto j = make_record();
+    const auto copied = j.get<MovedRecord>();
+
+    auto source = j;
+    const auto moved = json_ext::get<MovedRecord>(std::move(source));
+    EXPECT_EQ(json(moved), json(copied));
+    EXPECT_EQ(json(moved), j);
+
+    // an lvalue is copied and left as it is
+    auto lvalue = j;
+    EXPECT_EQ(json(json_ext::get<MovedRecord>(lvalue)), j);
+    EXPECT_EQ(lvalue, j);
+}
+
+TEST(TestMove, OkayStealsBuffers)
+{
+    auto j = make_record();
+    const auto *message = j["message"].get_ref<const std::string &>().data();
+    const auto *line = j["lines"][1].get_ref<const std::string &>().data();
+    const auto *comment = j["comment"].get_ref<const std::string &>().data();
+    const auto *name = j["payload"]["name"].get_ref<const std::string &>().data();
+    const auto *blob = j["payload"]["blob"].get_binary().data();
+    const auto *cell = j["table"][0][0].get_ref<const std::string &>().data();
+    const auto *nested = j["extra"]["nested"].get_ref<const std::string &>().data();
+
+    const auto record = json_ext::get<MovedRecord>(std::move(j));
+    EXPECT_EQ(record.message.data(), message);
+    EXPECT_EQ(record.lines[1].data(), line);
+    EXPECT_EQ(record.comment->data(), comment);
+    EXPECT_EQ(std::get<MovedAttachment>(record.payload).name.data(), name);
+    EXPECT_EQ(std::get<MovedAttachment>(record.payload).blob.data(), blob);
+    EXPECT_EQ(record.table[0][0].data(), cell);
+    EXPECT_EQ(record.extra["nested"].get_ref<const std::string &>().data(), nested);
+}
+
+TEST(TestMove, OkayUntaggedVariant)
+{
+    json j = {long_string('x'), long_string('y')};
+    const auto *data = j[0].get_ref<const std::string &>().data();
+
+    const auto value = json_ext::get<std::variant<int, std::vector<std::string>>>(std::move(j));
+    ASSERT_EQ(value.index(), 1);
+    EXPECT_EQ(std::get<1>(value)[0].data(), data);
+}
+
+TEST(TestMove, FailSameErrors)
+{
+    const auto missing = JSON({"lines" : [], "payload" : {"type" : "link", "url" : ""}});
+    EXPECT_EX(json_ext::get<MovedRecord>(json(missing)), "[json.exception.out_of_range.403] key 'message' not found");
+    EXPECT_EX(missing.get<MovedRecord>(), "[json.exception.out_of_range.403] key 'message' not found");
+
+    const auto wrong_type = JSON({"message" : "", "lines" : [1], "payload" : {"type" : "link", "url" : ""}});
+    EXPECT_EX(json_ext::get<MovedRecord>(json(wrong_type)),
+              "[json.exception.type_error.302] type must be string, but is number");
+    EXPECT_EX(wrong_type.get<MovedRecord>(), "[json.exception.type_error.302] type must be string, but is number");
+
+    const auto not_array = JSON({"message" : "", "lines" : {}, "payload" : {"type" : "link", "url" : ""}});
+    EXPECT_EX(json_ext::get<MovedRecord>(json(not_array)),
+              "[json.exception.type_error.302] type must be array, but is object");
+    EXPECT_EX(not_array.get<MovedRecord>(), "[json.exception.type_error.302] type must be array, but is object");
+
+    const auto unknown_key = JSON({"message" : "", "lines" : [], "payload" : {"type" : "link", "url" : ""}, "x" : 1});
+    const auto unknown_key_error = "[json.exception.other_error.600] key 'x' not present in reflected keys";
+    EXPECT_EX(json_ext::get<MovedRecord>(json(unknown_key)), unknown_key_error);
+    EXPECT_EX(unknown_key.get<MovedRecord>(), unknown_key_error);
+
+    const auto no_variant = JSON({"message" : "", "lines" : [], "comment" : null, "payload" : 1});
+    EXPECT_EX(json_ext::get<MovedRecord>(json(no_variant)),
+              "[json.exception.other_error.601] unable to find matching variant for number");
+    EXPECT_EX(no_variant.get<MovedRecord>(),
+              "[json.exception.other_error.601] unable to find matching variant for number");
+}
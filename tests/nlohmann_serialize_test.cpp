@@ -1,4 +1,6 @@
 #include <iostream>
+#include <memory_resource>
+#include <type_traits>
 
 #include <gtest/gtest.h>
 
@@ -122,7 +124,7 @@ TEST(TestNlohmannSerialize, OkayNonDefaultsFullOverrideMore)
 
     // fails with strict
     EXPECT_EX(j.get<OnlyNonDefaultsStrict>(),
-              "[json.exception.other_error.600] key 'c' not present in reflected keys: {\"a\":3,\"b\":4,\"c\":5}")
+              "[json.exception.other_error.600] key 'c' not present in reflected keys")
 }
 
 TEST(TestNlohmannSerialize, FailNonDefaultsValueMissing)
@@ -178,7 +180,7 @@ TEST(TestNlohmannSerialize, FailMixedDefaultNonDefault)
 
     // with strict this should fail before the key is checked
     EXPECT_EX(j1.get<MixedDefaultNonDefaultStrict>(),
-              "[json.exception.other_error.600] key 'c' not present in reflected keys: {\"c\":3}")
+              "[json.exception.other_error.600] key 'c' not present in reflected keys")
 
     // if it is empty it is fine with strict, still b is not present
     auto j2 = JSON({});
@@ -197,10 +199,147 @@ TEST(TestNlohmannSerialize, FailStrictEdgeCase)
 {
     auto j1 = JSON({"c" : 3});
     EXPECT_EX(j1.get<StrictEdgeCase>(),
-              "[json.exception.other_error.600] key 'c' not present in reflected keys: {\"c\":3}")
+              "[json.exception.other_error.600] key 'c' not present in reflected keys")
 
     // at least that works, there are more in the json than define on the class
     auto j2 = JSON({"a" : 1, "c" : 42});
     EXPECT_EX(j2.get<StrictEdgeCase>(),
-              "[json.exception.other_error.600] key 'c' not present in reflected keys: {\"a\":1,\"c\":42}")
+              "[json.exception.other_error.600] key 'c' not present in reflected keys")
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// STRICT KEY LOOKUP
+TEST(TestNlohmannSerialize, KeyTable)
+{
+    constexpr auto table = json_ext::detail::make_key_table(std::array<std::string_view, 4>{"a", "b", "ab", "ba"});
+    static_assert(table.size() == 4);
+    static_assert(table.find("a") == 0);
+    static_assert(table.find("ba") == 3);
+    static_assert(table.find("c") == json_ext::detail::npos);
+    static_assert(table.find("") == json_ext::detail::npos);
+
+    EXPECT_EQ(json_ext::detail::field_index<MixedDefaultNonDefaultStrict>("b"), 1);
+    EXPECT_EQ(json_ext::detail::field_index<MixedDefaultNonDefaultStrict>("c"), json_ext::detail::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// DEFAULTS ARE ONLY EVALUATED FOR MISSING KEYS
+struct CountedValue
+{
+    static inline int constructions = 0;
+
+    int value = 0;
+
+    CountedValue()
+    {
+        ++constructions;
+    }
+
+    CountedValue(int value) : value(value)
+    {
+        ++constructions;
+    }
+
+    friend void to_json(json &j, const CountedValue &counted)
+    {
+        j = counted.value;
+    }
+
+    friend void from_json(const json &j, CountedValue &counted)
+    {
+        counted.value = j.get<int>();
+    }
+};
+
+struct WithCountedDefault
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(WithCountedDefault,
+        (CountedValue, counted, 5)
+        (std::optional<int>, opt, 42)
+    )
+    // clang-format on
+};
+
+TEST(TestNlohmannSerialize, OkayNoDefaultObject)
+{
+    // only the object returned by get itself is constructed
+    CountedValue::constructions = 0;
+    auto obj1 = JSON({"counted" : 1, "opt" : null}).get<WithCountedDefault>();
+    EXPECT_EQ(CountedValue::constructions, 1);
+    EXPECT_EQ(obj1.counted.value, 1);
+    EXPECT_EQ(obj1.opt, std::nullopt);
+
+    CountedValue::constructions = 0;
+    // the object returned by get and the default value of the missing member
+    auto obj2 = JSON({}).get<WithCountedDefault>();
+    EXPECT_EQ(CountedValue::constructions, 2);
+    EXPECT_EQ(obj2.counted.value, 5);
+    EXPECT_EQ(obj2.opt, 42);
+}
+
+// defaults are evaluated in the context of the object, so they may refer to other members
+struct DefaultFromMember
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(DefaultFromMember,
+        (int, a, 1)
+        (int, b, a + 1)
+    )
+    // clang-format on
+};
+
+template <typename T, typename = void> struct has_public_default : std::false_type
+{
+};
+
+template <typename T>
+struct has_public_default<T, std::void_t<decltype(std::declval<const T &>().json_ext_default_b())>> : std::true_type
+{
+};
+
+TEST(TestNlohmannSerialize, OkayDefaultFromMember)
+{
+    // the generated default functions aren't part of the interface of the type
+    static_assert(!has_public_default<DefaultFromMember>::value);
+
+    EXPECT_EQ(json(JSON({}).get<DefaultFromMember>()), JSON({"a" : 1, "b" : 2}));
+    EXPECT_EQ(json(json_ext::parse_into<DefaultFromMember>("{}")), JSON({"a" : 1, "b" : 2}));
+    // the default sees the decoded member
+    EXPECT_EQ(json(JSON({"a" : 5}).get<DefaultFromMember>()), JSON({"a" : 5, "b" : 6}));
+    EXPECT_EQ(json(json_ext::parse_into<DefaultFromMember>(R"({"a": 5})")), JSON({"a" : 5, "b" : 6}));
+    std::pmr::monotonic_buffer_resource arena;
+    EXPECT_EQ(json(json_ext::parse_borrowed<DefaultFromMember>(R"({"a": 5})", arena)), JSON({"a" : 5, "b" : 6}));
+}
+
+int next_sequence()
+{
+    static int sequence = 0;
+    return ++sequence;
+}
+
+struct WithChangingDefault
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(WithChangingDefault,
+        (int, sequence, next_sequence())
+    )
+    // clang-format on
+};
+
+TEST(TestNlohmannSerialize, OkayDefaultEvaluatedPerDecode)
+{
+    const auto first = JSON({}).get<WithChangingDefault>().sequence;
+    EXPECT_NE(JSON({}).get<WithChangingDefault>().sequence, first);
+    EXPECT_NE(json_ext::parse_into<WithChangingDefault>("{}").sequence, first);
+    // the member initializer of the returned object evaluates it, the given key doesn't
+    const auto before = next_sequence();
+    EXPECT_EQ(JSON({"sequence" : 0}).get<WithChangingDefault>().sequence, 0);
+    EXPECT_EQ(next_sequence(), before + 2);
+}
+
+TEST(TestNlohmannSerialize, FailDefaultsNoObject)
+{
+    EXPECT_EX(JSON([]).get<OnlyDefaults>(), "[json.exception.type_error.306] cannot use value() with array")
+    EXPECT_EX(JSON(1).get<OnlyNonDefaults>(), "[json.exception.type_error.304] cannot use at() with number")
 }
@@ -0,0 +1,174 @@
+#include <limits>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+
+struct PatchLimits
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(PatchLimits,
+        (double, low)
+        (double, high)
+    )
+    // clang-format on
+};
+
+using PatchState = std::variant<int, std::string>;
+
+struct PatchSensor
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(PatchSensor,
+        (std::string, name)
+        (double, value, 0.0)
+        (PatchLimits, limits)
+        (std::optional<PatchLimits>, alarm, std::nullopt)
+        (std::vector<int>, history, {})
+        (PatchState, state, 0)
+    )
+    // clang-format on
+};
+
+struct PatchSnapshot
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT_TAGGED(PatchSnapshot, "snapshot",
+        (int, tick)
+        (PatchSensor, temperature)
+        (PatchSensor, pressure)
+    )
+    // clang-format on
+};
+
+static PatchSnapshot make_snapshot()
+{
+    return {1,
+            {"temperature", 21.5, {0, 100}, std::nullopt, {1, 2}, 0},
+            {"pressure", 1.0, {0, 2}, PatchLimits{0.5, 1.5}}};
+}
+
+TEST(TestPatch, OkayDiff)
+{
+    const auto baseline = make_snapshot();
+    auto current = baseline;
+    EXPECT_EQ(json_ext::diff(baseline, current), json::object());
+
+    current.tick = 2;
+    current.temperature.limits.high = 90;
+    current.temperature.history.push_back(3);
+    current.pressure.alarm->low = 0.7;
+    current.pressure.state = "alarm";
+
+    const auto patch = json_ext::diff(baseline, current);
+    EXPECT_EQ(patch, JSON({
+                  "tick" : 2,
+                  "temperature" : {"limits" : {"high" : 90.0}, "history" : [ 1, 2, 3 ]},
+                  "pressure" : {"alarm" : {"low" : 0.7}, "state" : "alarm"}
+              }));
+
+    // without changes to null the patch is a valid merge patch
+    auto merged = json(baseline);
+    merged.merge_patch(patch);
+    EXPECT_EQ(merged, json(current));
+
+    std::string written;
+    json_ext::write_diff(baseline, current, written);
+    EXPECT_EQ(written, patch.dump());
+}
+
+TEST(TestPatch, OkayOptional)
+{
+    const auto baseline = make_snapshot();
+    auto current = baseline;
+    current.temperature.alarm = PatchLimits{-10, 50};
+    current.pressure.alarm.reset();
+
+    const auto patch = json_ext::diff(baseline, current);
+    EXPECT_EQ(patch, JSON({"temperature" : {"alarm" : {"low" : -10.0, "high" : 50.0}}, "pressure" : {"alarm" : null}}));
+
+    std::string written;
+    json_ext::write_diff(baseline, current, written);
+    EXPECT_EQ(written, patch.dump());
+
+    auto patched = baseline;
+    json_ext::apply_patch(patched, patch);
+    EXPECT_EQ(json(patched), json(current));
+}
+
+TEST(TestPatch, OkayFloatingPoint)
+{
+    auto baseline = make_snapshot();
+    baseline.temperature.value = std::numeric_limits<double>::quiet_NaN();
+    baseline.pressure.value = 0.0;
+    auto current = baseline;
+    EXPECT_EQ(json_ext::diff(baseline, current), json::object());
+
+    std::string written;
+    json_ext::write_diff(baseline, current, written);
+    EXPECT_EQ(written, "{}");
+
+    current.temperature.value = 20.0;
+    current.pressure.value = -0.0;
+    const auto patch = json_ext::diff(baseline, current);
+    EXPECT_EQ(patch.dump(), R"({"pressure":{"value":-0.0},"temperature":{"value":20.0}})");
+
+    written.clear();
+    json_ext::write_diff(baseline, current, written);
+    EXPECT_EQ(written, patch.dump());
+
+    current.temperature.value = baseline.temperature.value;
+    EXPECT_EQ(json_ext::diff(current, baseline).dump(), R"({"pressure":{"value":0.0}})");
+}
+
+TEST(TestPatch, OkayApply)
+{
+    const auto baseline = make_snapshot();
+    auto current = baseline;
+    current.tick = 7;
+    current.temperature.name = "outside";
+    current.temperature.limits.low = -40;
+    current.pressure.alarm->high = 3;
+    current.pressure.history = {4, 5, 6};
+
+    auto patched = baseline;
+    const auto *name = patched.pressure.name.data();
+    json_ext::apply_patch(patched, json_ext::diff(baseline, current));
+    EXPECT_EQ(json(patched), json(current));
+    // untouched members stay as they are
+    EXPECT_EQ(patched.pressure.name.data(), name);
+
+    // the tag may be part of the patch
+    json_ext::apply_patch(patched, JSON({"type" : "snapshot", "tick" : 8}));
+    EXPECT_EQ(patched.tick, 8);
+}
+
+TEST(TestPatch, Fail)
+{
+    auto snapshot = make_snapshot();
+    EXPECT_EX(json_ext::apply_patch(snapshot, json(1)),
+              "[json.exception.type_error.302] type must be object, but is number");
+    EXPECT_EX(json_ext::apply_patch(snapshot, JSON({"unknown" : 1})),
+              "[json.exception.other_error.600] key 'unknown' not present in reflected keys");
+    EXPECT_EX(json_ext::apply_patch(snapshot, JSON({"type" : "other"})),
+              "[json.exception.other_error.602] expected type 'snapshot' but got: \"other\"");
+    EXPECT_EX(json_ext::apply_patch(snapshot, JSON({"temperature" : {"limits" : {"low" : "cold"}}})),
+              "[json.exception.type_error.302] type must be number, but is string");
+
+    // the members before the failing one stay patched
+    snapshot = make_snapshot();
+    EXPECT_EX(json_ext::apply_patch(snapshot, JSON({"pressure" : {"value" : 2.0}, "temperature" : {"value" : "hot"}})),
+              "[json.exception.type_error.302] type must be number, but is string");
+    EXPECT_EQ(snapshot.pressure.value, 2.0);
+
+    // non-strict types ignore unknown keys as from_json does
+    json_ext::apply_patch(snapshot.temperature, JSON({"unknown" : 1}));
+}
@@ -0,0 +1,140 @@
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+
+struct SaxInner
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(SaxInner,
+        (int, a)
+        (std::string, b, "b")
+    )
+    // clang-format on
+};
+
+struct SaxOther
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(SaxOther,
+        (int, c)
+    )
+    // clang-format on
+};
+
+// the macro can't handle commas inside of the type
+using SaxEither = std::variant<SaxInner, SaxOther>;
+
+struct SaxOuter
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(SaxOuter,
+        (int, id)
+        (double, value, 1.5)
+        (bool, flag, false)
+        (std::optional<SaxInner>, inner)
+        (std::vector<SaxInner>, inners, {})
+        (std::vector<std::vector<int>>, matrix, {})
+        (SaxEither, either, SaxOther{})
+        (std::optional<std::string>, name, "name")
+        (json, raw, nullptr)
+    )
+    // clang-format on
+};
+
+TEST(TestSax, OkayNested)
+{
+    auto text = std::string(R"({
+        "id": 1,
+        "value": 2,
+        "flag": true,
+        "unknown": {"x": [1, {"y": 2}], "z": null},
+        "inner": {"a": 3},
+        "inners": [{"a": 4, "b": "c"}, {"a": 5}],
+        "matrix": [[1, 2], [], [3]],
+        "either": {"c": 6},
+        "name": null,
+        "raw": {"any": ["thing"]}
+    })");
+
+    auto obj = json_ext::parse_into<SaxOuter>(text);
+    EXPECT_EQ(obj.id, 1);
+    EXPECT_EQ(obj.value, 2);
+    EXPECT_TRUE(obj.flag);
+    ASSERT_TRUE(obj.inner);
+    EXPECT_EQ(obj.inner->a, 3);
+    EXPECT_EQ(obj.inner->b, "b");
+    ASSERT_EQ(obj.inners.size(), 2);
+    EXPECT_EQ(obj.inners[0].b, "c");
+    EXPECT_EQ(obj.inners[1].a, 5);
+    EXPECT_EQ(obj.matrix, std::vector<std::vector<int>>({{1, 2}, {}, {3}}));
+    ASSERT_TRUE(std::holds_alternative<SaxOther>(obj.either));
+    EXPECT_EQ(std::get<SaxOther>(obj.either).c, 6);
+    EXPECT_EQ(obj.name, std::nullopt);
+    EXPECT_EQ(obj.raw, JSON({"any" : ["thing"]}));
+
+    // the same as the dom
+    EXPECT_EQ(static_cast<json>(obj), static_cast<json>(json::parse(text).get<SaxOuter>()));
+
+    std::istringstream stream(text);
+    EXPECT_EQ(static_cast<json>(json_ext::parse_into<SaxOuter>(stream)), static_cast<json>(obj));
+}
+
+TEST(TestSax, OkayDefaults)
+{
+    auto obj = json_ext::parse_into<SaxOuter>(R"({"id": 1, "inner": null})");
+    EXPECT_EQ(obj.value, 1.5);
+    EXPECT_FALSE(obj.flag);
+    EXPECT_EQ(obj.inner, std::nullopt);
+    EXPECT_TRUE(obj.inners.empty());
+    EXPECT_TRUE(std::holds_alternative<SaxOther>(obj.either));
+    EXPECT_EQ(obj.name, "name");
+    EXPECT_TRUE(obj.raw.is_null());
+
+    auto inners = json_ext::parse_into<std::vector<SaxInner>>(R"([{"a": 1}, {"a": 2, "b": "x"}])");
+    ASSERT_EQ(inners.size(), 2);
+    EXPECT_EQ(inners[0].b, "b");
+    EXPECT_EQ(inners[1].b, "x");
+}
+
+TEST(TestSax, FailSameAsDom)
+{
+    EXPECT_EX(json_ext::parse_into<SaxOuter>(R"({"inner": null})"),
+              "[json.exception.out_of_range.403] key 'id' not found")
+    EXPECT_EX(json_ext::parse_into<SaxOuter>(R"({"id": 1})"),
+              "[json.exception.out_of_range.403] key 'inner' not found")
+    EXPECT_EX(json_ext::parse_into<SaxInner>(R"({"a": 1, "c": 2})"),
+              "[json.exception.other_error.600] key 'c' not present in reflected keys")
+    EXPECT_EX(json_ext::parse_into<SaxInner>(R"({"a": "1"})"),
+              "[json.exception.type_error.302] type must be number, but is string")
+    EXPECT_EX(json_ext::parse_into<SaxInner>(R"({"a": 1, "b": 2})"),
+              "[json.exception.type_error.302] type must be string, but is number")
+    EXPECT_EX(json_ext::parse_into<SaxInner>(R"([])"), "[json.exception.type_error.304] cannot use at() with array")
+    EXPECT_EX(json_ext::parse_into<SaxOuter>(R"({"id": 1, "inner": null, "inners": {}})"),
+              "[json.exception.type_error.302] type must be array, but is object")
+    EXPECT_EX(json_ext::parse_into<SaxOuter>(R"({"id": 1, "inner": null, "either": {"d": 1}})"),
+              "[json.exception.other_error.601] unable to find matching variant for object")
+
+    // with several errors the first one found is thrown: the DOM checks all keys of a strict type first, parse_into
+    // streams. Both reject the json
+    const std::string type_then_key = R"({"a": "1", "c": 2})";
+    EXPECT_EX(json::parse(type_then_key).get<SaxInner>(),
+              "[json.exception.other_error.600] key 'c' not present in reflected keys")
+    EXPECT_EX(json_ext::parse_into<SaxInner>(type_then_key),
+              "[json.exception.type_error.302] type must be number, but is string")
+
+    // the DOM rejects the index of a non-empty array as unknown key, parse_into the array itself
+    EXPECT_EX(json::parse("[1]").get<SaxInner>(),
+              "[json.exception.other_error.600] key '0' not present in reflected keys")
+    EXPECT_EX(json_ext::parse_into<SaxInner>("[1]"), "[json.exception.type_error.304] cannot use at() with array")
+
+    EXPECT_EX(json_ext::parse_into<SaxInner>(R"({"a": 1)"),
+              "[json.exception.parse_error.101] parse error at line 1, column 8: syntax error while parsing object - "
+              "unexpected end of input; expected '}'")
+}
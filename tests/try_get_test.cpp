@@ -0,0 +1,242 @@
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "utils.hpp"
+
+using nlohmann::json;
+
+struct TryLeaf
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT_TAGGED(TryLeaf, "leaf",
+        (std::string, name)
+        (int, weight, 1)
+    )
+    // clang-format on
+};
+
+struct TryOther
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT_TAGGED(TryOther, "other",
+        (bool, flag)
+    )
+    // clang-format on
+};
+
+using TryNode = std::variant<TryLeaf, TryOther>;
+
+struct TryTree
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(TryTree,
+        (std::vector<TryNode>, nodes)
+        (std::optional<std::vector<int>>, weights, std::nullopt)
+    )
+    // clang-format on
+};
+
+TEST(TestTryGet, Okay)
+{
+    const auto j = JSON({"nodes" : [ {"type" : "leaf", "name" : "a"}, {"flag" : true} ], "weights" : [ 1, 2 ]});
+
+    const auto result = json_ext::try_get<TryTree>(j);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(json(*result), json(j.get<TryTree>()));
+    EXPECT_EQ(std::get<TryLeaf>(result->nodes[0]).weight, 1);
+
+    auto moved = j;
+    EXPECT_EQ(json(json_ext::try_get<TryTree>(std::move(moved)).value()), json(*result));
+}
+
+TEST(TestTryGet, FailTypeMismatch)
+{
+    const auto result = json_ext::try_get<TryTree>(JSON({"nodes" : [], "weights" : [ 1, "2" ]}));
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code, json_ext::decode_errc::type_mismatch);
+    EXPECT_EQ(result.error().expected, "number");
+    EXPECT_EQ(result.error().actual, "string");
+    EXPECT_EQ(result.error().pointer().to_string(), "/weights/1");
+    EXPECT_EQ(result.error().message(), "/weights/1: type must be number, but is string");
+
+    const auto root = json_ext::try_get<TryTree>(json(42));
+    ASSERT_FALSE(root);
+    EXPECT_EQ(root.error().message(), "type must be object, but is number");
+}
+
+TEST(TestTryGet, FailMissingKey)
+{
+    const auto result = json_ext::try_get<TryTree>(JSON({"nodes" : [ {"type" : "leaf"} ]}));
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code, json_ext::decode_errc::missing_key);
+    EXPECT_EQ(result.error().key, "name");
+    EXPECT_EQ(result.error().message(), "/nodes/0/name: key 'name' not found");
+}
+
+TEST(TestTryGet, FailUnknownKey)
+{
+    const auto result = json_ext::try_get<TryTree>(JSON({"nodes" : [ {"type" : "leaf", "name" : "a", "a/b" : 1} ]}));
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().code, json_ext::decode_errc::unknown_key);
+    EXPECT_EQ(result.error().key, "a/b");
+    EXPECT_EQ(result.error().pointer().to_string(), "/nodes/0/a~1b");
+    EXPECT_EQ(result.error().message(), "/nodes/0/a~1b: key 'a/b' not present in reflected keys");
+}
+
+TEST(TestTryGet, FailUnknownKeyLargeDocument)
+{
+    // neither the exception nor the decode_error contains the document
+    const json j = {{"type", "leaf"}, {"name", std::string(1 << 20, 'x')}, {"unknown", 1}};
+    EXPECT_EX(j.get<TryLeaf>(), "[json.exception.other_error.600] key 'unknown' not present in reflected keys");
+    const json untagged = {{"flag", std::string(1 << 20, 'x')}};
+    EXPECT_EX(json({{"nodes", {untagged}}}).get<TryTree>(),
+              "[json.exception.other_error.601] unable to find matching variant for object");
+
+    const auto result = json_ext::try_get<TryLeaf>(j);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().message(), "/unknown: key 'unknown' not present in reflected keys");
+}
+
+TEST(TestTryGet, FailVariant)
+{
+    // without a tag no alternative matches
+    const auto untagged = json_ext::try_get<TryTree>(JSON({"nodes" : [ {"flag" : 1} ]}));
+    ASSERT_FALSE(untagged);
+    EXPECT_EQ(untagged.error().code, json_ext::decode_errc::no_matching_variant);
+    EXPECT_EQ(untagged.error().message(), "/nodes/0: unable to find matching variant for object");
+
+    // with a tag the error of the tagged alternative is reported
+    const auto tagged = json_ext::try_get<TryTree>(JSON({"nodes" : [ {"type" : "other", "flag" : 1} ]}));
+    ASSERT_FALSE(tagged);
+    EXPECT_EQ(tagged.error().code, json_ext::decode_errc::type_mismatch);
+    EXPECT_EQ(tagged.error().message(), "/nodes/0/flag: type must be boolean, but is number");
+
+    const auto wrong_tag = json_ext::try_get<TryLeaf>(JSON({"type" : "other", "name" : "a"}));
+    ASSERT_FALSE(wrong_tag);
+    EXPECT_EQ(wrong_tag.error().code, json_ext::decode_errc::tag_mismatch);
+    EXPECT_EQ(wrong_tag.error().message(), "/type: expected type 'leaf'");
+}
+
+TEST(TestTryGet, FailSameAsGet)
+{
+    // whatever try_get rejects get throws for
+    const std::vector<json> rejected = {
+        JSON({}),
+        JSON({"nodes" : {}}),
+        JSON({"nodes" : [ {"type" : "leaf", "name" : 1} ]}),
+        JSON({"nodes" : [ {"type" : "unknown", "name" : "a"} ]}),
+        JSON({"nodes" : [], "weights" : [ null ]}),
+    };
+    for (const auto &j : rejected)
+    {
+        EXPECT_FALSE(json_ext::try_get<TryTree>(j)) << j;
+        EXPECT_ANY_THROW(j.get<TryTree>()) << j;
+    }
+}
+
+// from_json throws something which isn't a std::exception
+struct ThrowsInt
+{
+    friend void from_json(const json &, ThrowsInt &)
+    {
+        throw 42;
+    }
+};
+
+// the probe accepts every string, from_json only "ok"
+struct Picky
+{
+    friend void from_json(const json &j, Picky &)
+    {
+        if (j != "ok")
+            throw std::runtime_error("not ok");
+    }
+};
+
+template <> struct json_ext::probe<Picky>
+{
+    template <typename BasicJsonType>
+    static bool can_parse(const BasicJsonType &j, json_ext::decode_error *error = nullptr)
+    {
+        return j.is_string() || json_ext::detail::fail(error, json_ext::decode_errc::type_mismatch, j, "string");
+    }
+};
+
+struct TryCustom
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(TryCustom,
+        (std::optional<ThrowsInt>, throws, std::nullopt)
+        (std::optional<Picky>, picky, std::nullopt)
+    )
+    // clang-format on
+};
+
+// counts its decodings, the probe accepts every number
+struct Counted
+{
+    static inline std::size_t decoded = 0;
+
+    friend void from_json(const json &, Counted &)
+    {
+        ++decoded;
+    }
+};
+
+template <> struct json_ext::probe<Counted>
+{
+    template <typename BasicJsonType>
+    static bool can_parse(const BasicJsonType &j, json_ext::decode_error *error = nullptr)
+    {
+        return j.is_number() || json_ext::detail::fail(error, json_ext::decode_errc::type_mismatch, j, "number");
+    }
+};
+
+struct TryCounted
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(TryCounted,
+        (Counted, counted)
+        (int, id)
+    )
+    // clang-format on
+};
+
+TEST(TestTryGet, FailWithoutDecoding)
+{
+    // the probes reject the json before anything is decoded
+    Counted::decoded = 0;
+    const auto rejected = json_ext::try_get<TryCounted>(JSON({"counted" : 1, "id" : "1"}));
+    ASSERT_FALSE(rejected);
+    EXPECT_EQ(rejected.error().message(), "/id: type must be number, but is string");
+    EXPECT_EQ(Counted::decoded, 0);
+
+    EXPECT_TRUE(json_ext::try_get<TryCounted>(JSON({"counted" : 1, "id" : 1})));
+    EXPECT_EQ(Counted::decoded, 1);
+}
+
+TEST(TestTryGet, FailNeverThrows)
+{
+    EXPECT_FALSE(json_ext::can_parse<ThrowsInt>(json(1)));
+
+    const auto thrown = json_ext::try_get<TryCustom>(JSON({"throws" : 1}));
+    ASSERT_FALSE(thrown);
+    EXPECT_EQ(thrown.error().code, json_ext::decode_errc::conversion_failed);
+    EXPECT_EQ(thrown.error().message(), "/throws: unknown exception");
+
+    // the probe accepts what from_json rejects, the error of from_json is reported
+    const auto j = JSON({"picky" : "not ok"});
+    for (const auto &result : {json_ext::try_get<TryCustom>(j), json_ext::try_get<TryCustom>(json(j))})
+    {
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error().code, json_ext::decode_errc::conversion_failed);
+        EXPECT_EQ(result.error().message(), "not ok");
+    }
+    EXPECT_TRUE(json_ext::try_get<TryCustom>(JSON({"picky" : "ok"})));
+}
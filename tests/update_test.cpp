@@ -0,0 +1,128 @@
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+
+struct UpdateLevel
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(UpdateLevel,
+        (double, price)
+        (std::string, venue)
+    )
+    // clang-format on
+};
+
+struct UpdateTrade
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT_TAGGED(UpdateTrade, "trade",
+        (std::string, trade_id)
+    )
+    // clang-format on
+};
+
+struct UpdateQuote
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT_TAGGED(UpdateQuote, "quote",
+        (std::string, quote_id)
+        (int, size)
+    )
+    // clang-format on
+};
+
+using UpdateEvent = std::variant<UpdateTrade, UpdateQuote>;
+
+struct UpdateMessage
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(UpdateMessage,
+        (std::string, symbol)
+        (std::vector<UpdateLevel>, levels)
+        (std::optional<std::vector<std::string>>, flags, std::nullopt)
+        (UpdateEvent, event)
+        (std::string, source, "exchange")
+    )
+    // clang-format on
+};
+
+static json make_message(int i)
+{
+    // all strings are longer than the small string buffer and differ per message
+    const auto text = [i](const char *prefix) { return prefix + std::string(32, 'x') + std::to_string(i); };
+    return {{"symbol", text("symbol-")},
+            {"levels", {{{"price", i * 1.5}, {"venue", text("venue-")}}, {{"price", i * 2.5}, {"venue", text("v-")}}}},
+            {"flags", {text("flag-")}},
+            {"event", {{"type", "quote"}, {"quote_id", text("quote-")}, {"size", i}}}};
+}
+
+TEST(TestUpdate, OkaySameAsGet)
+{
+    UpdateMessage message;
+    for (int i = 0; i < 3; ++i)
+    {
+        const auto j = make_message(i);
+        json_ext::update(message, j);
+        EXPECT_EQ(json(message), json(j.get<UpdateMessage>()));
+    }
+
+    // missing members get their default values again
+    message.source = "somewhere else";
+    auto j = make_message(3);
+    j.erase("flags");
+    json_ext::update(message, j);
+    EXPECT_FALSE(message.flags.has_value());
+    EXPECT_EQ(message.source, "exchange");
+
+    // the alternative is switched
+    j["event"] = {{"type", "trade"}, {"trade_id", "t"}};
+    json_ext::update(message, j);
+    EXPECT_EQ(std::get<UpdateTrade>(message.event).trade_id, "t");
+
+    // fewer elements
+    j["levels"] = json::array();
+    json_ext::update(message, std::move(j));
+    EXPECT_TRUE(message.levels.empty());
+}
+
+TEST(TestUpdate, OkayKeepsAllocations)
+{
+    UpdateMessage message;
+    json_ext::update(message, make_message(0));
+    const auto *symbol = message.symbol.data();
+    const auto *levels = message.levels.data();
+    const auto *venue = message.levels[1].venue.data();
+    const auto *flag = message.flags->front().data();
+    const auto *quote_id = std::get<UpdateQuote>(message.event).quote_id.data();
+
+    const auto j = make_message(1);
+    const auto before = global_allocations;
+    json_ext::update(message, j);
+    const auto after = global_allocations;
+
+    EXPECT_EQ(after, before);
+    EXPECT_EQ(message.symbol.data(), symbol);
+    EXPECT_EQ(message.levels.data(), levels);
+    EXPECT_EQ(message.levels[1].venue.data(), venue);
+    EXPECT_EQ(message.flags->front().data(), flag);
+    EXPECT_EQ(std::get<UpdateQuote>(message.event).quote_id.data(), quote_id);
+    EXPECT_EQ(json(message), json(j.get<UpdateMessage>()));
+}
+
+TEST(TestUpdate, FailSameErrors)
+{
+    UpdateMessage message;
+    auto j = make_message(0);
+    j["levels"][1]["price"] = "1";
+    EXPECT_EX(json_ext::update(message, j), "[json.exception.type_error.302] type must be number, but is string");
+    EXPECT_EX(j.get<UpdateMessage>(), "[json.exception.type_error.302] type must be number, but is string");
+}
@@ -1,4 +1,8 @@
 #pragma once
+#include <cstddef>
+
+// counts every call of the global operator new, see allocations.cpp
+extern std::size_t global_allocations;
 
 #define EXPECT_EX(function, expected_exception_msg)                                                                    \
     {                                                                                                                  \
@@ -73,9 +73,9 @@ TEST(TestVariant, OkayWithOptionals)
 {
     auto j1 = JSON({"a" : 1, "b" : 2, "c" : 3});
     EXPECT_EX(j1.get<WithOptionalAB>(),
-              "[json.exception.other_error.601] unable to find matching variant for: {\"a\":1,\"b\":2,\"c\":3}");
+              "[json.exception.other_error.601] unable to find matching variant for object");
     EXPECT_EX(j1.get<WithOptionalBA>(),
-              "[json.exception.other_error.601] unable to find matching variant for: {\"a\":1,\"b\":2,\"c\":3}");
+              "[json.exception.other_error.601] unable to find matching variant for object");
 
     auto j2 = JSON({"a" : 1, "b" : 2});
     auto v2_ab = j2.get<WithOptionalAB>();
@@ -116,16 +116,16 @@ TEST(TestVariant, OkayStrictTypeIntersection)
 {
     auto j1 = JSON({"a" : 1, "b" : 2, "c" : 3});
     EXPECT_EX(j1.get<StrictTypeIntersectionAB>(),
-              "[json.exception.other_error.601] unable to find matching variant for: {\"a\":1,\"b\":2,\"c\":3}");
+              "[json.exception.other_error.601] unable to find matching variant for object");
     EXPECT_EX(j1.get<StrictTypeIntersectionBA>(),
-              "[json.exception.other_error.601] unable to find matching variant for: {\"a\":1,\"b\":2,\"c\":3}");
+              "[json.exception.other_error.601] unable to find matching variant for object");
 
     auto j2 = JSON({"a" : 1});
     auto v2_ab = j2.get<StrictTypeIntersectionAB>();
     auto v2_ba = j2.get<StrictTypeIntersectionBA>();
-    // edge case this effects the type depending on the variant order
+    // both match, the most specific one wins independent of the variant order
     EXPECT_TRUE(std::holds_alternative<StrictTypeIntersectionA>(v2_ab));
-    EXPECT_TRUE(std::holds_alternative<StrictTypeIntersectionB>(v2_ba));
+    EXPECT_TRUE(std::holds_alternative<StrictTypeIntersectionA>(v2_ba));
 
     auto j3 = JSON({"a" : 1, "b" : 2});
     auto v3_ab = j3.get<StrictTypeIntersectionAB>();
@@ -133,3 +133,323 @@ TEST(TestVariant, OkayStrictTypeIntersection)
     EXPECT_TRUE(std::holds_alternative<StrictTypeIntersectionB>(v3_ab));
     EXPECT_TRUE(std::holds_alternative<StrictTypeIntersectionB>(v3_ba));
 }
+
+struct ProbedA
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(ProbedA,
+        (int, a)
+    )
+    // clang-format on
+};
+
+struct ProbedB
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(ProbedB,
+        (int, a)
+        (int, b, 2)
+    )
+    // clang-format on
+};
+
+static std::size_t probes = 0;
+
+// counts the probes of both alternatives, checks only the member they share
+struct counting_probe
+{
+    template <typename BasicJsonType>
+    static bool can_parse(const BasicJsonType &j, json_ext::decode_error *error = nullptr)
+    {
+        ++probes;
+        if (!j.is_object() || !j.contains("a") || !j["a"].is_number_integer())
+            return json_ext::detail::fail(error, json_ext::decode_errc::type_mismatch, j, "object with integer a");
+        return true;
+    }
+};
+
+template <> struct json_ext::probe<ProbedA> : counting_probe
+{
+};
+
+template <> struct json_ext::probe<ProbedB> : counting_probe
+{
+};
+
+TEST(TestVariant, OkayProbeOnlyTies)
+{
+    using ProbedAB = std::variant<ProbedA, ProbedB>;
+
+    // only ProbedB allows "b", it is decoded without probing
+    probes = 0;
+    EXPECT_TRUE(std::holds_alternative<ProbedB>(JSON({"a" : 1, "b" : 3}).get<ProbedAB>()));
+    EXPECT_EQ(probes, 0);
+
+    // both allow {"a"}, the most specific one is probed before the last candidate is decoded
+    probes = 0;
+    EXPECT_TRUE(std::holds_alternative<ProbedA>(JSON({"a" : 1}).get<ProbedAB>()));
+    EXPECT_EQ(probes, 1);
+
+    probes = 0;
+    EXPECT_EX(JSON({"a" : "1", "b" : 3}).get<ProbedAB>(),
+              "[json.exception.other_error.601] unable to find matching variant for object");
+    EXPECT_EQ(probes, 0);
+
+    probes = 0;
+    EXPECT_EX(JSON({"a" : "1"}).get<ProbedAB>(),
+              "[json.exception.other_error.601] unable to find matching variant for object");
+    EXPECT_EQ(probes, 1);
+}
+
+// from_json throws something which isn't a std::exception
+struct ThrowsInt
+{
+    friend void from_json(const nlohmann::json &, ThrowsInt &)
+    {
+        throw 42;
+    }
+};
+
+struct WithThrowsInt
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(WithThrowsInt,
+        (ThrowsInt, x)
+    )
+    // clang-format on
+};
+
+TEST(TestVariant, FailUnknownExceptionOfLastCandidate)
+{
+    // the only candidate is decoded without probing, its failure is the variant's failure whatever it throws
+    using Either = std::variant<WithThrowsInt, A>;
+    EXPECT_EX(JSON({"x" : 1}).get<Either>(),
+              "[json.exception.other_error.601] unable to find matching variant for object");
+}
+
+struct First
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(First,
+        (int, first)
+    )
+    // clang-format on
+};
+
+struct Second
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(Second,
+        (std::string, second)
+        (std::optional<int>, opt, 42)
+    )
+    // clang-format on
+};
+
+struct Third
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(Third,
+        (std::vector<int>, third)
+    )
+    // clang-format on
+};
+
+using FirstSecondThird = std::variant<First, Second, Third>;
+
+TEST(TestVariant, CanParse)
+{
+    EXPECT_TRUE(json_ext::can_parse<First>(JSON({"first" : 1})));
+    EXPECT_FALSE(json_ext::can_parse<First>(JSON({"first" : "1"})));
+    EXPECT_FALSE(json_ext::can_parse<First>(JSON({"first" : 1, "second" : "2"})));
+    EXPECT_FALSE(json_ext::can_parse<First>(JSON([1])));
+
+    EXPECT_TRUE(json_ext::can_parse<Second>(JSON({"second" : "2"})));
+    EXPECT_TRUE(json_ext::can_parse<Second>(JSON({"second" : "2", "opt" : null})));
+    EXPECT_FALSE(json_ext::can_parse<Second>(JSON({"second" : "2", "opt" : "42"})));
+    EXPECT_FALSE(json_ext::can_parse<Second>(JSON({"opt" : 1})));
+
+    // non-strict ignores additional keys
+    EXPECT_TRUE(json_ext::can_parse<Third>(JSON({"third" : [ 1, 2 ], "first" : 1})));
+    EXPECT_FALSE(json_ext::can_parse<Third>(JSON({"third" : [ 1, "2" ]})));
+
+    EXPECT_TRUE(json_ext::can_parse<FirstSecondThird>(JSON({"third" : []})));
+    EXPECT_FALSE(json_ext::can_parse<FirstSecondThird>(JSON({"fourth" : []})));
+}
+
+TEST(TestVariant, OkayProbeAlternatives)
+{
+    auto v1 = JSON({"first" : 1}).get<FirstSecondThird>();
+    EXPECT_TRUE(std::holds_alternative<First>(v1));
+
+    auto v2 = JSON({"second" : "2"}).get<FirstSecondThird>();
+    ASSERT_TRUE(std::holds_alternative<Second>(v2));
+    EXPECT_EQ(std::get<Second>(v2).second, "2");
+    EXPECT_EQ(std::get<Second>(v2).opt, 42);
+
+    auto v3 = JSON({"third" : [ 1, 2, 3 ]}).get<FirstSecondThird>();
+    ASSERT_TRUE(std::holds_alternative<Third>(v3));
+    EXPECT_EQ(std::get<Third>(v3).third, std::vector<int>({1, 2, 3}));
+
+    EXPECT_EX(JSON({"third" : [ "1" ]}).get<FirstSecondThird>(),
+              "[json.exception.other_error.601] unable to find matching variant for object");
+}
+
+struct NonStrictA
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(NonStrictA,
+        (int, a)
+    )
+    // clang-format on
+};
+
+struct NonStrictAB
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(NonStrictAB,
+        (int, a)
+        (int, b)
+    )
+    // clang-format on
+};
+
+TEST(TestVariant, KeySignature)
+{
+    using signature = json_ext::key_signature<StrictTypeIntersectionB>;
+    static_assert(signature::strict);
+    static_assert(signature::allowed.size == 2);
+    static_assert(signature::required.size == 1);
+    static_assert(signature::required.keys[0] == "a");
+
+    using variant_signature = json_ext::detail::variant_signature<First, Second, Third>;
+    static_assert(variant_signature::keys.size() == 4);
+    static_assert(variant_signature::required[1] == 0b0010);
+    static_assert(variant_signature::allowed[1] == 0b0110);
+}
+
+TEST(TestVariant, OkayMostSpecificNonStrict)
+{
+    // non strict alternatives accept additional keys, the one covering most keys wins
+    auto j1 = JSON({"a" : 1, "b" : 2, "c" : 3});
+    EXPECT_TRUE(std::holds_alternative<NonStrictAB>(j1.get<std::variant<NonStrictA, NonStrictAB>>()));
+    EXPECT_TRUE(std::holds_alternative<NonStrictAB>(j1.get<std::variant<NonStrictAB, NonStrictA>>()));
+
+    auto j2 = JSON({"a" : 1, "c" : 3});
+    EXPECT_TRUE(std::holds_alternative<NonStrictA>(j2.get<std::variant<NonStrictA, NonStrictAB>>()));
+    EXPECT_TRUE(std::holds_alternative<NonStrictA>(j2.get<std::variant<NonStrictAB, NonStrictA>>()));
+}
+
+TEST(TestVariant, OkayNonReflectedAlternatives)
+{
+    using Mixed = std::variant<int, std::string, A>;
+    EXPECT_TRUE(std::holds_alternative<int>(JSON(1).get<Mixed>()));
+    EXPECT_TRUE(std::holds_alternative<std::string>(JSON("a").get<Mixed>()));
+    EXPECT_TRUE(std::holds_alternative<A>(JSON({"a" : 1}).get<Mixed>()));
+    EXPECT_EX(JSON([]).get<Mixed>(), "[json.exception.other_error.601] unable to find matching variant for array");
+}
+
+struct Created
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_TAGGED(Created, "created",
+        (int, id)
+    )
+    // clang-format on
+};
+
+struct Deleted
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_TAGGED(Deleted, "deleted",
+        (int, id)
+        (bool, soft, false)
+    )
+    // clang-format on
+};
+
+struct Renamed
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT_TAGGED(Renamed, "renamed",
+        (int, id)
+        (std::string, name)
+    )
+    // clang-format on
+};
+
+using Event = std::variant<Created, Deleted, Renamed>;
+
+// a member named or aliased as the tag key would be written twice and read from the tag, decoding or encoding these
+// types fails to compile with a static_assert
+struct TagAsMember
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_TAGGED(TagAsMember, "tag_as_member",
+        (std::string, type)
+    )
+    // clang-format on
+};
+
+struct TagAsAlias
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT_TAGGED(TagAsAlias, "tag_as_alias",
+        (std::string, kind, , "type")
+    )
+    // clang-format on
+};
+
+// untagged types may use the name
+struct UntaggedTypeMember
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(UntaggedTypeMember,
+        (std::string, type)
+    )
+    // clang-format on
+};
+
+static_assert(!json_ext::detail::tag_key_is_free<TagAsMember>());
+static_assert(!json_ext::detail::tag_key_is_free<TagAsAlias>());
+static_assert(json_ext::detail::tag_key_is_free<Renamed>());
+static_assert(json_ext::detail::tag_key_is_free<UntaggedTypeMember>());
+
+TEST(TestVariant, OkayTagged)
+{
+    // the tag is written by to_json
+    EXPECT_EQ(nlohmann::json(Event(Deleted{1, true})), JSON({"type" : "deleted", "id" : 1, "soft" : true}));
+
+    // the tag decides, although all alternatives could parse the json
+    auto e1 = JSON({"type" : "deleted", "id" : 1}).get<Event>();
+    ASSERT_TRUE(std::holds_alternative<Deleted>(e1));
+    EXPECT_EQ(std::get<Deleted>(e1).id, 1);
+    EXPECT_FALSE(std::get<Deleted>(e1).soft);
+
+    // the tag is a reflected key of strict types
+    auto e2 = JSON({"name" : "x", "type" : "renamed", "id" : 2}).get<Event>();
+    ASSERT_TRUE(std::holds_alternative<Renamed>(e2));
+    EXPECT_EQ(std::get<Renamed>(e2).name, "x");
+    EXPECT_NO_THROW(JSON({"type" : "renamed", "id" : 2, "name" : "x"}).get<Renamed>());
+
+    // without tag the alternatives are tried as before
+    auto e3 = JSON({"id" : 3, "soft" : true}).get<Event>();
+    ASSERT_TRUE(std::holds_alternative<Deleted>(e3));
+
+    for (const auto &e : {e1, e2, e3})
+        EXPECT_EQ(json_ext::dump(e), nlohmann::json(e).dump());
+}
+
+TEST(TestVariant, FailTagged)
+{
+    EXPECT_EX(JSON({"type" : "moved", "id" : 1}).get<Event>(),
+              "[json.exception.other_error.601] unable to find matching variant for object");
+    // the tag is not a hint, the selected alternative has to parse
+    EXPECT_EX(JSON({"type" : "renamed", "id" : 1}).get<Event>(),
+              "[json.exception.out_of_range.403] key 'name' not found");
+    EXPECT_EX(JSON({"type" : "created", "id" : 1}).get<Deleted>(),
+              "[json.exception.other_error.602] expected type 'deleted' but got: \"created\"");
+    EXPECT_EX(json_ext::parse_into<Deleted>(R"({"type": 1, "id": 1})"),
+              "[json.exception.other_error.602] expected type 'deleted' but got: 1");
+    EXPECT_EQ(json_ext::parse_into<Renamed>(R"({"type": "renamed", "id": 1, "name": "x"})").id, 1);
+}
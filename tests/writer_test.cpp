@@ -0,0 +1,107 @@
+#include <limits>
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json_ext.hpp>
+
+#include "./utils.hpp"
+
+using nlohmann::json;
+
+struct WriterInner
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE_STRICT(WriterInner,
+        (std::string, text)
+        (int, number, 1)
+    )
+    // clang-format on
+};
+
+struct WriterOther
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(WriterOther,
+        (std::vector<double>, values)
+    )
+    // clang-format on
+};
+
+using WriterEither = std::variant<WriterInner, WriterOther, std::string>;
+using WriterMap = std::map<std::string, int>;
+
+struct WriterOuter
+{
+    // clang-format off
+    NLOHMANN_SERIALIZE(WriterOuter,
+        (int, zeta, -1)
+        (unsigned, alpha, 0)
+        (std::uint64_t, big, std::numeric_limits<std::uint64_t>::max())
+        (std::int64_t, small, std::numeric_limits<std::int64_t>::min())
+        (bool, flag, true)
+        (float, ratio, 0.1f)
+        (double, precise, 0.1)
+        (std::optional<WriterInner>, inner)
+        (std::optional<WriterInner>, empty)
+        (std::vector<WriterEither>, eithers, {})
+        (WriterMap, map, {})
+        (json, raw, nullptr)
+        (char, character, 'a')
+    )
+    // clang-format on
+};
+
+TEST(TestWriter, OkaySameAsDump)
+{
+    WriterOuter obj;
+    obj.inner = WriterInner{"inner", 2};
+    obj.eithers = {WriterInner{"a"}, WriterOther{{1.0, -0.0, 1e300, 1.5e-7}}, std::string("b")};
+    obj.map = {{"z", 1}, {"a", 2}, {"\n", 3}};
+    obj.raw = JSON({"b" : [ 1, 2 ], "a" : null});
+
+    EXPECT_EQ(json_ext::dump(obj), json(obj).dump());
+    EXPECT_EQ(json_ext::dump(std::vector<WriterOuter>{obj, WriterOuter{}}),
+              json(std::vector<WriterOuter>{obj, WriterOuter{}}).dump());
+
+    // appends to the string
+    std::string out = "prefix";
+    json_ext::write(obj, out);
+    EXPECT_EQ(out, "prefix" + json(obj).dump());
+
+    // output iterator
+    std::vector<char> chars;
+    json_ext::write(obj.inner, std::back_inserter(chars));
+    EXPECT_EQ(std::string(chars.begin(), chars.end()), json(obj.inner).dump());
+}
+
+TEST(TestWriter, OkayNumbers)
+{
+    for (double value : {0.0, -0.0, 1.0, 0.1, 1.0 / 3.0, 1e-300, 1e300, -123456.789, 4.35, 1e16, 1.0e-5})
+        EXPECT_EQ(json_ext::dump(value), json(value).dump());
+
+    EXPECT_EQ(json_ext::dump(std::numeric_limits<double>::quiet_NaN()), "null");
+    EXPECT_EQ(json_ext::dump(-std::numeric_limits<double>::infinity()), "null");
+    EXPECT_EQ(json_ext::dump(3.14f), json(3.14f).dump());
+    EXPECT_EQ(json_ext::dump(-42), "-42");
+}
+
+TEST(TestWriter, OkayEscaping)
+{
+    for (std::string value : {std::string("plain"), std::string("quote \" backslash \\ slash /"),
+                              std::string("\b\f\n\r\t"), std::string("\x01\x1f\x7f", 3), std::string("\0", 1),
+                              std::string("ünïcödé 😀"), std::string("")})
+        EXPECT_EQ(json_ext::dump(value), json(value).dump());
+}
+
+TEST(TestWriter, FailInvalidUtf8)
+{
+    EXPECT_EX(json_ext::dump(std::string("ab\xC3(")), "[json.exception.type_error.316] invalid UTF-8 byte at index 3: 0x28")
+    EXPECT_EX(json(std::string("ab\xC3(")).dump(), "[json.exception.type_error.316] invalid UTF-8 byte at index 3: 0x28")
+
+    EXPECT_EX(json_ext::dump(std::string("ab\xE2\x82")),
+              "[json.exception.type_error.316] incomplete UTF-8 string; last byte: 0x82")
+    EXPECT_EX(json(std::string("ab\xE2\x82")).dump(),
+              "[json.exception.type_error.316] incomplete UTF-8 string; last byte: 0x82")
+}